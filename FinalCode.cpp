@@ -6,6 +6,22 @@
 #include <queue> 
 #include <algorithm>
 #include <iomanip>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cmath>
+#include <climits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ZOMBIE_HAVE_AVX2 1
+#else
+#define ZOMBIE_HAVE_AVX2 0
+#endif
 
 using namespace std;
 
@@ -14,16 +30,30 @@ using namespace std;
 // =====================================================
 struct Player;
 class MapGraph;
-class ZombieSystem;
+class ZombieBackend;
 class Inventory;
 
+// Dense item ids: inventory and loot compare these, names are for display only
+enum ItemId {
+    ITEM_BREAD, ITEM_APPLE, ITEM_PILLS, ITEM_ENERGY_DRINK, ITEM_CLOTH, ITEM_FIRST_AID, ITEM_JUNK, ITEM_PEBBLE, ITEM_TWIG,
+    ITEM_AXE, ITEM_GUN, ITEM_AMMO, ITEM_BACKPACK, ITEM_BOOK, ITEM_PETROL, ITEM_CAR_KEYS, ITEM_USER_ID, ITEM_PIN,
+    ITEM_COUNT // must stay last
+};
+
+// One bit per item type, for "owns all of these" tests in a single AND
+typedef unsigned int ItemMask;
+static_assert(ITEM_COUNT <= 32, "ItemMask has one bit per item");
+inline ItemMask itemBit(ItemId item) { return 1u << item; }
+const ItemMask WIN_ITEMS = itemBit(ITEM_PIN) | itemBit(ITEM_USER_ID);
+const ItemMask ARMED_ITEMS = itemBit(ITEM_GUN) | itemBit(ITEM_AMMO);
+
 // Global helper declarations
-void useJunkAtCurrentNode(Player& player, Inventory& inv, ZombieSystem& zsys);
-void usePebble(Player& player, Inventory& inv, MapGraph& map, ZombieSystem& zsys);
-void useTwig(Player& player, Inventory& inv, MapGraph& map, ZombieSystem& zsys);
+void useJunkAtCurrentNode(Player& player, Inventory& inv, ZombieBackend& zsys);
+void usePebble(Player& player, Inventory& inv, MapGraph& map, ZombieBackend& zsys);
+void useTwig(Player& player, Inventory& inv, MapGraph& map, ZombieBackend& zsys);
 void useEnergyDrink(Player& player, Inventory& inv, bool& playerAlive);
 void usePills(Player& player, Inventory& inv, bool& playerAlive);
-void useFood(Player& player, Inventory& inv, string itemName, int hpGain);
+void useFood(Player& player, Inventory& inv, ItemId item, int hpGain);
 void useCloth(Player& player, Inventory& inv);
 void useAxeOnBridge(MapGraph& map, Player& player, Inventory& inv);
 
@@ -82,8 +112,9 @@ enum Location {
 
 struct Node {
     int vertex;
+    int minutes; // zombie travel time along this edge; 0 = crossed within one action
     Node* next;
-    Node(int v) { vertex = v; next = NULL; }
+    Node(int v, int m = 0) { vertex = v; minutes = m; next = NULL; }
 };
 
 string locationToString(Location loc) {
@@ -106,9 +137,34 @@ string locationToString(Location loc) {
     }
 }
 
+string itemToString(ItemId item) {
+    switch (item) {
+    case ITEM_BREAD: return "Bread";
+    case ITEM_APPLE: return "Apple";
+    case ITEM_PILLS: return "Pills";
+    case ITEM_ENERGY_DRINK: return "Energy Drink";
+    case ITEM_CLOTH: return "Cloth";
+    case ITEM_FIRST_AID: return "First Aid";
+    case ITEM_JUNK: return "Junk";
+    case ITEM_PEBBLE: return "Pebble";
+    case ITEM_TWIG: return "Twig";
+    case ITEM_AXE: return "Axe";
+    case ITEM_GUN: return "Gun";
+    case ITEM_AMMO: return "Ammo";
+    case ITEM_BACKPACK: return "Backpack";
+    case ITEM_BOOK: return "Book";
+    case ITEM_PETROL: return "Petrol";
+    case ITEM_CAR_KEYS: return "Car Keys";
+    case ITEM_USER_ID: return "User ID";
+    case ITEM_PIN: return "PIN";
+    default: return "Unknown";
+    }
+}
+
 struct ItemProb {
-    string name;
-    double probability;
+    ItemId item;
+    int basisPoints; // chance per scavenge in 1/10000
+    int stock;       // units left to find here; the chance drops to 0 with the last
 };
 
 struct Player {
@@ -124,37 +180,83 @@ struct Player {
     int adrenalineMovesLeft;
 };
 
+// =====================================================
+//              NODE POOL
+// =====================================================
+// Typed free-list pool for the linked structures. Nodes come out of fixed-size
+// chunks and freed nodes are reused; the owner (one game's MapGraph)
+// hands every chunk back in one shot when it goes away.
+template <class T>
+class NodePool {
+private:
+    static_assert(is_trivially_destructible<T>::value, "pooled nodes are released without running destructors");
+    static const int CHUNK = 64;
+    union Slot {
+        Slot* nextFree;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    vector<Slot*> chunks;
+    Slot* freeList;
+    int usedInChunk;
+
+public:
+    NodePool() : freeList(NULL), usedInChunk(CHUNK) {}
+    ~NodePool() { for (Slot* c : chunks) delete[] c; }
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template <class... Args> T* create(Args&&... args) {
+        Slot* slot;
+        if (freeList) { slot = freeList; freeList = slot->nextFree; }
+        else {
+            if (usedInChunk == CHUNK) { chunks.push_back(new Slot[CHUNK]); usedInChunk = 0; }
+            slot = &chunks.back()[usedInChunk++];
+        }
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* node) {
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->nextFree = freeList;
+        freeList = slot;
+    }
+};
+
 // =====================================================
 //              INVENTORY CLASS
 // =====================================================
-struct InvNode {
-    string name;
-    string description;
+// One stack of an item. Slots hold no pointers, so a whole Inventory can be
+// copied with memcpy (e.g. to clone a game state for a rollout).
+struct InvSlot {
+    ItemId item;
+    const char* description; // always a string literal
     int quantity;
-    InvNode* prev;
-    InvNode* next;
-    InvNode(const string& n, const string& d, int q)
-        : name(n), description(d), quantity(q), prev(NULL), next(NULL) {}
 };
 
 class Inventory {
 private:
-    InvNode* head;
-    InvNode* tail;
-    InvNode* current;
+    static const int MAX_SLOTS = 12; // backpack capacity; every stack takes at least one slot
+    InvSlot slots[MAX_SLOTS];        // in pickup order
+    int slotCount;
+    int current;                     // cursor into slots, -1 = nothing selected
+    int slotOf[ITEM_COUNT];          // item -> its stack in slots, -1 if not held
+    ItemMask owned;                  // bit set while a stack of that item exists
     int capacity;
     int usedSlots; // Represents total occupied space (sum of all quantities)
     bool hasBackpack;
 
 public:
     Inventory(int cap = 8) {
-        head = tail = current = NULL;
-        capacity = cap;
+        slotCount = 0;
+        current = -1;
+        for (int i = 0; i < ITEM_COUNT; i++) slotOf[i] = -1;
+        owned = 0;
+        capacity = cap > MAX_SLOTS ? MAX_SLOTS : cap;
         usedSlots = 0;
         hasBackpack = false;
     }
 
-    bool isEmpty() const { return head == NULL; }
+    bool isEmpty() const { return slotCount == 0; }
     // Full if total occupied slots (including stacks) equals capacity
     bool isFull() const { return usedSlots >= capacity; } 
     int getCapacity() const { return capacity; }
@@ -165,295 +267,947 @@ public:
             cout << ">> [Inventory] Capacity is already " << capacity << ".\n";
             return;
         }
-        capacity = 12;
+        capacity = MAX_SLOTS;
         hasBackpack = true;
         cout << ">> [Inventory] Backpack obtained! Capacity increased to 12 slots.\n";
     }
 
-    bool contains(const string& itemName) {
-        InvNode* temp = head;
-        while (temp) {
-            if (temp->name == itemName) return true;
-            temp = temp->next;
-        }
-        return false;
-    }
+    bool contains(ItemId item) const { return (owned & itemBit(item)) != 0; }
+    // Stacks vanish at quantity 0, so an owned bit also means "at least one"
+    bool ownsAll(ItemMask items) const { return (owned & items) == items; }
 
     // UPDATED LOGIC: Stacks Quantity AND increases Occupied Space
-    bool addItem(const string& name, const string& desc, int quantity = 1) {
+    bool addItem(ItemId item, const char* desc, int quantity = 1) {
         // 1. Check Capacity first (assuming we add +1 quantity, we need +1 space)
         if (usedSlots + quantity > capacity) {
             return false; // Not enough space
         }
 
         // 2. Try to Stack
-        InvNode* temp = head;
-        while (temp != NULL) {
-            if (temp->name == name) {
-                temp->quantity += quantity;
-                usedSlots += quantity; // INCREASE OCCUPIED SPACE even if stacking
-                cout << ">> [Inventory] Stacked " << name << ". New qty: " << temp->quantity << " (Occupies " << temp->quantity << " slots)\n";
-                return true; 
-            }
-            temp = temp->next;
+        if (slotOf[item] >= 0) {
+            InvSlot& stack = slots[slotOf[item]];
+            stack.quantity += quantity;
+            usedSlots += quantity; // INCREASE OCCUPIED SPACE even if stacking
+            cout << ">> [Inventory] Stacked " << itemToString(item) << ". New qty: " << stack.quantity << " (Occupies " << stack.quantity << " slots)\n";
+            return true; 
         }
 
-        // 3. New Item Node
-        InvNode* node = new InvNode(name, desc, quantity);
-        if (!head) { head = tail = node; }
-        else { tail->next = node; node->prev = tail; tail = node; }
+        // 3. New Item Slot
+        if (slotCount == MAX_SLOTS) return false;
+        slots[slotCount].item = item;
+        slots[slotCount].description = desc;
+        slots[slotCount].quantity = quantity;
+        slotOf[item] = slotCount++;
+        owned |= itemBit(item);
         
         usedSlots += quantity; // INCREASE OCCUPIED SPACE
-        cout << ">> [Inventory] Added: " << name << "\n";
+        cout << ">> [Inventory] Added: " << itemToString(item) << "\n";
         return true; 
     }
 
-    void deleteNode(InvNode* node) {
-        if (!node) return;
-        cout << ">> [Inventory] Discarded: " << node->name << " (x" << node->quantity << ")\n";
+    // Removes a whole stack; later stacks shift down so the list order is kept
+    void deleteSlot(int index) {
+        if (index < 0 || index >= slotCount) return;
+        cout << ">> [Inventory] Discarded: " << itemToString(slots[index].item) << " (x" << slots[index].quantity << ")\n";
         
-        // When deleting a whole node, we free up space equal to its quantity
-        usedSlots -= node->quantity;
-
-        if (node->prev) node->prev->next = node->next;
-        else head = node->next;
-        if (node->next) node->next->prev = node->prev;
-        else tail = node->prev;
-        if (current == node) {
-            if (node->next) current = node->next;
-            else current = node->prev;
+        // When deleting a whole stack, we free up space equal to its quantity
+        usedSlots -= slots[index].quantity;
+        slotOf[slots[index].item] = -1;
+        owned &= ~itemBit(slots[index].item);
+        for (int i = index + 1; i < slotCount; i++) {
+            slots[i - 1] = slots[i];
+            slotOf[slots[i - 1].item] = i - 1;
         }
-        delete node;
+        slotCount--;
+
+        // Cursor stays on the same neighbour the linked list would have picked
+        if (current > index) current--;
+        else if (current == index && current == slotCount) current = slotCount - 1;
     }
 
     void deleteCurrent() {
-        if (!current) { cout << "Nothing selected.\n"; return; }
-        deleteNode(current);
+        if (current < 0) { cout << "Nothing selected.\n"; return; }
+        deleteSlot(current);
     }
 
     void showCurrent() {
-        if (!current) { cout << "     (No item selected)\n"; return; }
-        cout << "\n   > SELECTED: " << current->name << " (x" << current->quantity << ")\n";
-        cout << "     Desc: " << current->description << "\n";
+        if (current < 0) { cout << "     (No item selected)\n"; return; }
+        cout << "\n   > SELECTED: " << itemToString(slots[current].item) << " (x" << slots[current].quantity << ")\n";
+        cout << "     Desc: " << slots[current].description << "\n";
     }
 
     void moveNext() {
-        if (!current) current = head;
-        else if (current->next) current = current->next;
+        if (current < 0) current = slotCount > 0 ? 0 : -1;
+        else if (current + 1 < slotCount) current++;
         else cout << "   (End of list)\n";
     }
 
     void moveBack() {
-        if (!current) current = head;
-        else if (current->prev) current = current->prev;
+        if (current < 0) current = slotCount > 0 ? 0 : -1;
+        else if (current > 0) current--;
         else cout << "   (Start of list)\n";
     }
 
-    bool consumeOne(const string& itemName) {
-        InvNode* temp = head;
-        while (temp) {
-            if (temp->name == itemName) {
-                temp->quantity--;
-                usedSlots--; // Free up 1 unit of space
-                
-                if (temp->quantity <= 0) {
-                    // Node is empty. deleteNode will try to subtract quantity (0) from usedSlots
-                    // which is correct (we already subtracted 1 above).
-                    deleteNode(temp);
-                }
-                return true;
-            }
-            temp = temp->next;
-        }
-        return false;
-    }
+    bool consumeOne(ItemId item) {
+        int index = slotOf[item];
+        if (index < 0) return false;
+        slots[index].quantity--;
+        usedSlots--; // Free up 1 unit of space
 
-    bool consumeMany(const string& itemName, int count) {
-        int remaining = count;
-        InvNode* temp = head;
-        while (temp && remaining > 0) {
-            if (temp->name == itemName) {
-                if (temp->quantity > remaining) {
-                    // Partial consumption
-                    temp->quantity -= remaining;
-                    usedSlots -= remaining; // Manually update space
-                    remaining = 0;
-                }
-                else {
-                    // Full node consumption
-                    remaining -= temp->quantity;
-                    // deleteNode handles `usedSlots -= temp->quantity` automatically
-                    InvNode* toDelete = temp;
-                    temp = temp->next;
-                    deleteNode(toDelete);
-                    continue;
-                }
-            }
-            if (temp) temp = temp->next;
+        if (slots[index].quantity <= 0) {
+            // Stack is empty. deleteSlot will try to subtract quantity (0) from usedSlots
+            // which is correct (we already subtracted 1 above).
+            deleteSlot(index);
         }
-        return remaining == 0;
+        return true;
     }
 
-    int countItem(const string& itemName) const {
-        int total = 0;
-        InvNode* temp = head;
-        while (temp) {
-            if (temp->name == itemName) total += temp->quantity;
-            temp = temp->next;
+    // Items stack into one slot, so this is one index lookup instead of a list walk
+    bool consumeMany(ItemId item, int count) {
+        int index = slotOf[item];
+        if (count <= 0) return true;
+        if (index < 0) return false;
+        if (slots[index].quantity > count) {
+            // Partial consumption
+            slots[index].quantity -= count;
+            usedSlots -= count; // Manually update space
+            return true;
         }
-        return total;
+        // Full stack consumption; deleteSlot handles `usedSlots -= quantity` automatically
+        int taken = slots[index].quantity;
+        deleteSlot(index);
+        return taken == count;
     }
 
+    int countItem(ItemId item) const { return slotOf[item] >= 0 ? slots[slotOf[item]].quantity : 0; }
+
     void listItemsWithIndex() {
         cout << "\n[Inventory] Items:\n";
-        InvNode* temp = head;
-        int idx = 1;
-        while (temp) {
-            cout << idx << ". " << temp->name << " (x" << temp->quantity << ")\n";
-            temp = temp->next;
-            idx++;
+        for (int i = 0; i < slotCount; i++) {
+            cout << i + 1 << ". " << itemToString(slots[i].item) << " (x" << slots[i].quantity << ")\n";
         }
-        if (idx == 1) cout << "(empty)\n";
+        if (slotCount == 0) cout << "(empty)\n";
         cout << "\n";
     }
 
-    void deleteByIndex(int index) {
-        InvNode* temp = head;
-        int idx = 1;
-        while (temp && idx < index) { temp = temp->next; idx++; }
-        if (!temp) return;
-        deleteNode(temp);
-    }
+    // 1-based, as shown by listItemsWithIndex
+    void deleteByIndex(int index) { deleteSlot(index - 1); }
 
-    void openMenu(Player& player, MapGraph& map, ZombieSystem& zsys, bool& playerAlive);
-    InvNode* getCurrentNode() { return current; }
-    void resetCurrent() { if(!current) current = head; }
+    void openMenu(Player& player, MapGraph& map, ZombieBackend& zsys, bool& playerAlive);
+    const InvSlot* getCurrentSlot() const { return current < 0 ? NULL : &slots[current]; }
+    void resetCurrent() { if (current < 0 && slotCount > 0) current = 0; }
 };
+static_assert(is_trivially_copyable<Inventory>::value, "game-state clones copy the inventory with memcpy");
 
 // =====================================================
 //              OTHER SYSTEMS
 // =====================================================
 
-struct MoveNodeDLL {
+// One undo step: where the player was and the clock before a move
+struct MoveRecord {
     Location locBefore;
     int timeBefore;
-    MoveNodeDLL* prev;
-    MoveNodeDLL* next;
-    MoveNodeDLL(Location l, int t) : locBefore(l), timeBefore(t), prev(NULL), next(NULL) {}
 };
 
-class MoveLog {
+// Undo history as a fixed ring buffer: the newest Depth moves are kept and older
+// ones are overwritten. No allocation, and the log copies with the state.
+template <int Depth>
+class MoveRing {
+    static_assert(Depth >= 1, "the undo log needs room for at least one move");
 private:
-    MoveNodeDLL* head;
-    MoveNodeDLL* tail;
+    MoveRecord ring[Depth];
+    int newest; // index of the last pushed record
+    int count;
 public:
-    MoveLog() { head = tail = NULL; }
-    bool isEmpty() const { return tail == NULL; }
+    MoveRing() : newest(Depth - 1), count(0) {}
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+    int capacity() const { return Depth; }
     void push(Location locBefore, int timeBefore) {
-        MoveNodeDLL* node = new MoveNodeDLL(locBefore, timeBefore);
-        if (!head) head = tail = node;
-        else { tail->next = node; node->prev = tail; tail = node; }
+        newest = (newest + 1 == Depth) ? 0 : newest + 1;
+        ring[newest].locBefore = locBefore;
+        ring[newest].timeBefore = timeBefore;
+        if (count < Depth) count++;
     }
     bool pop(Location& locOut, int& timeOut) {
-        if (!tail) return false;
-        MoveNodeDLL* node = tail;
-        locOut = node->locBefore;
-        timeOut = node->timeBefore;
-        tail = node->prev;
-        if (tail) tail->next = NULL;
-        else head = NULL;
-        delete node;
+        if (count == 0) return false;
+        locOut = ring[newest].locBefore;
+        timeOut = ring[newest].timeBefore;
+        newest = (newest == 0) ? Depth - 1 : newest - 1;
+        count--;
         return true;
     }
 };
+typedef MoveRing<64> MoveLog;
+static_assert(is_trivially_copyable<MoveLog>::value, "game-state clones copy the move log with memcpy");
 
 // =====================================================
 //                  ZOMBIE SYSTEM
 // =====================================================
+// Infection tree node: which location infected which. Nodes live in one
+// vector (InfectionTree) and link by index, so any number of children fit.
 struct InfectionNode {
     Location loc;
-    InfectionNode* left;
-    InfectionNode* right;
-    InfectionNode(Location l) : loc(l), left(nullptr), right(nullptr) {}
+    int parent;           // -1 for an outbreak root
+    int firstChild;
+    int lastChild;
+    int nextSibling;
+    int depth;            // roots are depth 0
+    int subtreeSize;      // this node plus all descendants
+    int infectedAtMinute;
 };
 
+class InfectionTree {
+private:
+    vector<InfectionNode> nodes;
+    vector<int> roots;
+    int nodeOfLocation[COUNT]; // -1 = never infected
+
+public:
+    InfectionTree() { for (int i = 0; i < COUNT; i++) nodeOfLocation[i] = -1; }
+
+    // Every initial horde starts its own lineage, even on a node that is already infected
+    int addRoot(Location loc, int minute) {
+        int id = newNode(loc, -1, 0, minute);
+        roots.push_back(id);
+        return id;
+    }
+
+    // Insert is O(depth) so that subtreeSize stays an O(1) query
+    int addChild(int parent, Location loc, int minute) {
+        int id = newNode(loc, parent, nodes[parent].depth + 1, minute);
+        InfectionNode& p = nodes[parent];
+        if (p.lastChild < 0) p.firstChild = id;
+        else nodes[p.lastChild].nextSibling = id;
+        p.lastChild = id;
+        for (int a = parent; a >= 0; a = nodes[a].parent) nodes[a].subtreeSize++;
+        return id;
+    }
+
+    const InfectionNode& node(int id) const { return nodes[id]; }
+    int size() const { return (int)nodes.size(); }
+    const vector<int>& getRoots() const { return roots; }
+    int nodeAt(Location loc) const { return nodeOfLocation[loc]; }
+    int depth(int id) const { return nodes[id].depth; }
+    int subtreeSize(int id) const { return nodes[id].subtreeSize; }
+    // Minute the location was infected, -1 if it is still clean
+    int infectedAt(Location loc) const { return nodeOfLocation[loc] < 0 ? -1 : nodes[nodeOfLocation[loc]].infectedAtMinute; }
+
+    // Lineage from the outbreak root down to this node
+    vector<Location> ancestorChain(int id) const {
+        vector<Location> chain(nodes[id].depth + 1);
+        for (int a = id; a >= 0; a = nodes[a].parent) chain[nodes[a].depth] = nodes[a].loc;
+        return chain;
+    }
+
+private:
+    int newNode(Location loc, int parent, int depth, int minute) {
+        InfectionNode n = { loc, parent, -1, -1, -1, depth, 1, minute };
+        nodes.push_back(n);
+        if (nodeOfLocation[loc] < 0) nodeOfLocation[loc] = (int)nodes.size() - 1; // first infection wins
+        return (int)nodes.size() - 1;
+    }
+};
+
+// Per-location countdown (Junk, distractions) plus the list of locations whose
+// timer is running, so a tick and the "anything active?" check never scan the map.
+class LocationTimers {
+private:
+    int left[COUNT];
+    vector<Location> active;
+
+public:
+    LocationTimers() { for (int i = 0; i < COUNT; i++) left[i] = 0; }
+
+    int operator[](int loc) const { return left[loc]; }
+    bool any() const { return !active.empty(); }
+
+    // A location is in `active` exactly while its timer is above 0
+    void set(Location loc, int turns) {
+        if (turns > 0 && left[loc] == 0) active.push_back(loc);
+        if (turns <= 0 && left[loc] > 0) {
+            vector<Location>::iterator it = find(active.begin(), active.end(), loc);
+            *it = active.back();
+            active.pop_back();
+        }
+        left[loc] = turns > 0 ? turns : 0;
+    }
+
+    // Counts every live timer down by `turns`; onExpire(loc) runs for each that reaches 0
+    template <class F> void tick(int turns, F onExpire) {
+        for (size_t k = 0; k < active.size();) {
+            Location loc = active[k];
+            if ((left[loc] -= turns) <= 0) {
+                left[loc] = 0;
+                active[k] = active.back();
+                active.pop_back();
+                onExpire(loc);
+            } else k++;
+        }
+    }
+    template <class F> void tick(F onExpire) { tick(1, onExpire); }
+    void tick(int turns = 1) { tick(turns, [](Location) {}); }
+
+    // Turns until the first live timer runs out, 0 if none is running
+    int soonest() const {
+        int best = 0;
+        for (Location loc : active) if (best == 0 || left[loc] < best) best = left[loc];
+        return best;
+    }
+};
+
+// Counter-based RNG (Philox4x32-10, Salmon et al. 2011). Output is a pure function
+// of (key, counter), so any thread can produce any draw and nothing is shared.
+struct Philox4x32 {
+    unsigned int v[4];
+
+    Philox4x32(unsigned long long key, unsigned int c0, unsigned int c1, unsigned int c2, unsigned int c3) {
+        unsigned int k0 = (unsigned int)key, k1 = (unsigned int)(key >> 32);
+        v[0] = c0; v[1] = c1; v[2] = c2; v[3] = c3;
+        for (int round = 0; round < 10; round++) {
+            unsigned long long p0 = 0xD2511F53ULL * v[0];
+            unsigned long long p1 = 0xCD9E8D57ULL * v[2];
+            unsigned int n0 = (unsigned int)(p1 >> 32) ^ v[1] ^ k0;
+            unsigned int n2 = (unsigned int)(p0 >> 32) ^ v[3] ^ k1;
+            v[0] = n0; v[1] = (unsigned int)p1; v[2] = n2; v[3] = (unsigned int)p0;
+            k0 += 0x9E3779B9; k1 += 0xBB67AE85;
+        }
+    }
+};
+
+// Maps a 32-bit draw onto [0, n) without a division
+inline unsigned int rollBelow(unsigned int bits, unsigned int n) {
+    return (unsigned int)(((unsigned long long)bits * n) >> 32);
+}
+
+// =====================================================
+//      BATCHED HORDE ROLLS (AVX2 WITH SCALAR FALLBACK)
+// =====================================================
+// Lanes are hordes laid out structure-of-arrays. For every lane the kernel runs
+// the Philox block for (id, tick, 0) and derives the three rolls of one action:
+//  - word 0: rest roll, returned as a bitmask of lanes with roll < 15
+//  - word 1: index into that horde's open neighbours (degrees[l] of them)
+//  - word 2: infection roll 0..99
+const int ROLL_LANES = 8;
+typedef unsigned int (*HordeRollKernel)(unsigned long long seed, unsigned int tick, const unsigned int* ids,
+                                        const unsigned int* degrees, unsigned int* neighbourIdx, unsigned int* infectRoll);
+// Bitmask of lanes with infectRoll < rate
+typedef unsigned int (*InfectCompareKernel)(const unsigned int* infectRoll, const int* rates);
+
+unsigned int hordeRollsScalar(unsigned long long seed, unsigned int tick, const unsigned int* ids,
+                              const unsigned int* degrees, unsigned int* neighbourIdx, unsigned int* infectRoll) {
+    unsigned int restMask = 0;
+    for (int l = 0; l < ROLL_LANES; l++) {
+        Philox4x32 r(seed, ids[l], tick, 0, 0);
+        if (rollBelow(r.v[0], 100) < 15) restMask |= 1u << l;
+        neighbourIdx[l] = rollBelow(r.v[1], degrees[l]);
+        infectRoll[l] = rollBelow(r.v[2], 100);
+    }
+    return restMask;
+}
+
+unsigned int infectCompareScalar(const unsigned int* infectRoll, const int* rates) {
+    unsigned int mask = 0;
+    for (int l = 0; l < ROLL_LANES; l++) if ((int)infectRoll[l] < rates[l]) mask |= 1u << l;
+    return mask;
+}
+
+#if ZOMBIE_HAVE_AVX2
+// 32x32 -> 64 multiply of all eight lanes, split into high and low halves
+__attribute__((target("avx2"))) static inline void mulhilo8(__m256i a, __m256i b, __m256i& hi, __m256i& lo) {
+    __m256i even = _mm256_mul_epu32(a, b);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+__attribute__((target("avx2"))) unsigned int hordeRollsAVX2(unsigned long long seed, unsigned int tick, const unsigned int* ids,
+                                                            const unsigned int* degrees, unsigned int* neighbourIdx, unsigned int* infectRoll) {
+    const __m256i m0 = _mm256_set1_epi32((int)0xD2511F53), m1 = _mm256_set1_epi32((int)0xCD9E8D57);
+    __m256i v0 = _mm256_loadu_si256((const __m256i*)ids);
+    __m256i v1 = _mm256_set1_epi32((int)tick);
+    __m256i v2 = _mm256_setzero_si256(), v3 = _mm256_setzero_si256();
+    unsigned int k0 = (unsigned int)seed, k1 = (unsigned int)(seed >> 32);
+    for (int round = 0; round < 10; round++) {
+        __m256i hi0, lo0, hi1, lo1;
+        mulhilo8(v0, m0, hi0, lo0);
+        mulhilo8(v2, m1, hi1, lo1);
+        v0 = _mm256_xor_si256(_mm256_xor_si256(hi1, v1), _mm256_set1_epi32((int)k0));
+        v1 = lo1;
+        v2 = _mm256_xor_si256(_mm256_xor_si256(hi0, v3), _mm256_set1_epi32((int)k1));
+        v3 = lo0;
+        k0 += 0x9E3779B9; k1 += 0xBB67AE85;
+    }
+    const __m256i hundred = _mm256_set1_epi32(100);
+    __m256i hi, lo;
+    mulhilo8(v0, hundred, hi, lo);
+    unsigned int restMask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(15), hi)));
+    mulhilo8(v1, _mm256_loadu_si256((const __m256i*)degrees), hi, lo);
+    _mm256_storeu_si256((__m256i*)neighbourIdx, hi);
+    mulhilo8(v2, hundred, hi, lo);
+    _mm256_storeu_si256((__m256i*)infectRoll, hi);
+    return restMask;
+}
+
+__attribute__((target("avx2"))) unsigned int infectCompareAVX2(const unsigned int* infectRoll, const int* rates) {
+    __m256i rolls = _mm256_loadu_si256((const __m256i*)infectRoll);
+    __m256i r = _mm256_loadu_si256((const __m256i*)rates);
+    return (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(r, rolls)));
+}
+#endif
+
+// Runs from the static initializers below, possibly before libgcc has set up its
+// CPU model, so that has to be done here first.
+static bool cpuHasAVX2() {
+#if ZOMBIE_HAVE_AVX2
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+#if ZOMBIE_HAVE_AVX2
+static const HordeRollKernel hordeRollKernel = cpuHasAVX2() ? hordeRollsAVX2 : hordeRollsScalar;
+static const InfectCompareKernel infectCompareKernel = cpuHasAVX2() ? infectCompareAVX2 : infectCompareScalar;
+#else
+static const HordeRollKernel hordeRollKernel = hordeRollsScalar;
+static const InfectCompareKernel infectCompareKernel = infectCompareScalar;
+#endif
+
+// Horde behaviour policies. Each one is a set of compile-time switches that
+// ZombieSystem::moveHordeOneStep<Policy> is instantiated with, so a run of hordes
+// sharing a behaviour is stepped with the other behaviours' rules compiled out.
+enum Behaviour { DISTRACTION_SEEKER, RANDOM_WALK, PLAYER_HUNTER, STATIONARY, BEHAVIOUR_COUNT };
+
+struct DistractionSeeker { static const bool followsNoise = true,  huntsPlayer = false, moves = true;  };
+struct RandomWalk        { static const bool followsNoise = false, huntsPlayer = false, moves = true;  };
+struct PlayerHunter      { static const bool followsNoise = false, huntsPlayer = true,  moves = true;  };
+struct Stationary        { static const bool followsNoise = false, huntsPlayer = false, moves = false; };
+
 struct ZombieHorde {
     int id;
     Location currentLocation;
     int infectionRate;
-    InfectionNode* treeNode;
-    ZombieHorde(int _id, Location loc, int rate, InfectionNode* node)
-        : id(_id), currentLocation(loc), infectionRate(rate), treeNode(node) {}
+    int treeNode;          // index into the InfectionTree
+    int minutesPerAction;  // 60 = the classic hourly horde; fast/slow types use other values
+    int nextActionMinute;  // when the scheduler wakes this horde next
+    bool parked;           // blocked by Junk on every side, waiting for something to change
+    Behaviour behaviour;
+    int size;              // zombies in this horde; above 1 only in merge mode
+    Location travellingFrom; // on the edge travellingFrom -> currentLocation until nextActionMinute; COUNT = on a node
+    ZombieHorde(int _id, Location loc, int rate, int node, int speed = 60, Behaviour b = DISTRACTION_SEEKER)
+        : id(_id), currentLocation(loc), infectionRate(rate), treeNode(node),
+          minutesPerAction(speed), nextActionMinute(0), parked(false), behaviour(b), size(1), travellingFrom(COUNT) {}
+
+    // Each zombie rolls on its own, so a horde infects unless all of them miss
+    int effectiveInfectionRate() const {
+        if (size == 1 || infectionRate >= 100) return infectionRate;
+        return (int)(100.0 * (1.0 - pow(1.0 - infectionRate / 100.0, size)) + 0.5);
+    }
+};
+
+// What a fastForward() call reports instead of the per-horde log
+struct FastForwardSummary {
+    int infections;     // nodes newly infected
+    int spawns;         // split hordes created
+    int hordesAtPlayer; // hordes on the player's node at the end
+};
+
+// Agenda entry; stale entries (killed or rescheduled hordes) are skipped when popped
+struct ScheduledAction {
+    int minute;
+    int hordeId;
+    bool operator>(const ScheduledAction& o) const {
+        return minute != o.minute ? minute > o.minute : hordeId > o.hordeId;
+    }
 };
 
-class ZombieSystem {
+// What the game needs from a zombie simulation. ZombieSystem tracks every horde;
+// AggregateZombieSystem only keeps counts, for city-scale outbreaks.
+class ZombieBackend {
+public:
+    virtual ~ZombieBackend() {}
+    virtual void addInitialHorde(Location loc) = 0;
+    virtual void applyJunk(Location loc) = 0;
+    virtual void applyDistraction(Location loc, int duration) = 0;
+    virtual int countHordesAt(Location loc) const = 0;
+    virtual int countZombiesAt(Location loc) const = 0;
+    virtual bool isHordeAt(Location loc) const = 0;
+    virtual void removeAllHordesAt(Location loc) = 0;
+    virtual void removeOneHordeAt(Location loc) = 0;
+    virtual int interceptOnEdge(Location a, Location b, Location landAt) = 0;
+    virtual void moveHordesToward(Location target, int radius = 1) = 0;
+    virtual void setPlayerLocation(Location loc) = 0;
+    virtual void advance(int deltaMinutes) = 0;
+    // Advances `hours` without printing the per-step log
+    virtual FastForwardSummary fastForward(int hours, Location playerLoc) = 0;
+};
+
+// Prints what the player sees when a Pebble or Twig goes down; shared by both backends
+void announceDistraction(Location loc, int duration) {
+    string type = (duration == 1) ? "Twig" : "Pebble";
+    cout << ">> [" << type << "] You created a distraction at " << locationToString(loc) << ".\n";
+    cout << "   Zombies will be attracted there for " << duration << " turn(s).\n";
+}
+
+// Threads that outlive a batch, so stepping an hour starts none. run(n, job, ctx)
+// calls job(ctx, w) for every w in [0, n): 0 on the caller, the rest on the pool.
+class WorkerPool {
 private:
+    vector<thread> threads;
+    mutex lock;
+    condition_variable wake, finished;
+    void (*job)(void*, int);
+    void* ctx;
+    int generation; // bumped once per run()
+    int wanted;     // workers taking part in the current run
+    int pending;    // of those, pool threads still busy
+    bool stopping;
+
+    void loop(int w, int seen) {
+        unique_lock<mutex> hold(lock);
+        while (true) {
+            wake.wait(hold, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            if (w >= wanted) continue;
+            hold.unlock();
+            job(ctx, w);
+            hold.lock();
+            if (--pending == 0) finished.notify_one();
+        }
+    }
+
+public:
+    WorkerPool() : job(0), ctx(0), generation(0), wanted(0), pending(0), stopping(false) {}
+    ~WorkerPool() {
+        { lock_guard<mutex> hold(lock); stopping = true; }
+        wake.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    void run(int n, void (*fn)(void*, int), void* arg) {
+        while ((int)threads.size() < n - 1) threads.emplace_back(&WorkerPool::loop, this, (int)threads.size() + 1, generation);
+        {
+            lock_guard<mutex> hold(lock);
+            job = fn; ctx = arg; wanted = n; pending = n - 1;
+            generation++;
+        }
+        wake.notify_all();
+        fn(arg, 0);
+        unique_lock<mutex> hold(lock);
+        finished.wait(hold, [this] { return pending == 0; });
+    }
+};
+
+class ZombieSystem : public ZombieBackend {
+private:
+    // Outcome of one horde's step, printed later in horde order
+    enum StepKind { STEP_BLOCKED, STEP_DISTRACTED, STEP_TO_NOISE, STEP_RESTING, STEP_SHAMBLE, STEP_TO_PLAYER,
+                    STEP_DEPART, STEP_ARRIVE };
+    enum { DRAW_REST, DRAW_NEIGHBOUR, DRAW_INFECT };
+    static const int MIN_HORDES_PER_WORKER = 4096;
+
     vector<ZombieHorde> hordes;
-    int junkBlocks[COUNT];
-    int distractionTurns[COUNT];
+    LocationTimers junkBlocks;
+    LocationTimers distractionTurns;
     int nextId;
     bool infected[COUNT];
-    InfectionNode* infectionRoot;
+    InfectionTree tree;
     MapGraph* map; 
 
+    unsigned long long seed; // every zombie roll is keyed on (seed, horde id, action minute, draw)
+    int workerThreads;       // 0 = pick from hardware_concurrency
+    Location playerLocation; // what PLAYER_HUNTER hordes chase, COUNT = unknown
+
+    // Scheduler: hordes wake at their own nextActionMinute, Junk/distraction
+    // timers tick on the hour. Parked hordes are not on the agenda at all.
+    int clockMinutes;
+    vector<ScheduledAction> agenda; // min-heap under greater<>, kept to a bounded size by pruneAgenda()
+    vector<int> indexOfId;       // horde id -> index in hordes, -1 once killed
+    vector<int> occupants[COUNT]; // ids of the hordes on each node, in no particular order
+    vector<int> inTransit[COUNT][COUNT]; // ids of the hordes on each directed edge
+    vector<int> slotOfId;         // horde id -> position in its occupants[] or inTransit[][] list
+    vector<int> parkedAt[COUNT]; // ids of parked hordes per node
+    vector<Location> parkedNodes; // every node with a non-empty parkedAt (and maybe some emptied since)
+    bool listedParked[COUNT];     // node is in parkedNodes
+    int lastMeetingMinute[COUNT];
+
+    // Per-batch scratch, read-only while the workers run
+    vector<Location> openNeighbors[COUNT];
+    Location distractionStep[COUNT];
+    Location hunterStep[COUNT];
+    int travelMinutes[COUNT][COUNT];
+    bool anyDistraction;
+    vector<int> due;             // indices of the hordes acting now, ascending
+    vector<Location> dueFrom;
+    vector<int> stepOrder;       // positions in `due`, grouped by behaviour
+    int typeStart[BEHAVIOUR_COUNT + 1]; // stepOrder[typeStart[b] .. typeStart[b+1]) has behaviour b
+    vector<unsigned char> stepKinds;
+    vector<unsigned char> claimed; // per position: rolled an infection on a node clean at batch start
+    vector<ZombieHorde> spawned;
+    vector<int> mergeKeep;
+    WorkerPool pool;
+    int batchWorkers;
+
+    bool quiet;                  // fastForward: no log output
+    bool merging;                // co-located hordes fuse into one sized horde
+    int infectionCount;
+    int spawnCount;
+
 public:
     ZombieSystem(MapGraph* m); 
 
-    void addInitialHorde(Location loc) {
-        InfectionNode* node = new InfectionNode(loc);
-        if (!infectionRoot) infectionRoot = node;
-        ZombieHorde h(nextId++, loc, 5, node); // Starts at 5%
-        hordes.push_back(h);
+    void addInitialHorde(Location loc) override { addInitialHorde(loc, 60); }
+    void addInitialHorde(Location loc, int minutesPerAction, Behaviour behaviour = DISTRACTION_SEEKER) {
+        int node = tree.addRoot(loc, clockMinutes);
+        ZombieHorde h(nextId++, loc, 5, node, minutesPerAction, behaviour); // Starts at 5%
+        addHorde(h);
         infected[loc] = true;
     }
 
-    void applyJunk(Location loc) {
-        junkBlocks[loc] = 2;
+    void applyJunk(Location loc) override {
+        junkBlocks.set(loc, 2);
         cout << ">> [Junk] The path is blocked. Zombies will be repelled for 2 turns.\n";
     }
 
-    void applyDistraction(Location loc, int duration) {
-        distractionTurns[loc] = duration;
-        string type = (duration == 1) ? "Twig" : "Pebble";
-        cout << ">> [" << type << "] You created a distraction at " << locationToString(loc) << ".\n";
-        cout << "   Zombies will be attracted there for " << duration << " turn(s).\n";
+    void applyDistraction(Location loc, int duration) override {
+        distractionTurns.set(loc, duration);
+        announceDistraction(loc, duration);
+        for (int i = 0; i < COUNT; i++) wakeParkedAt((Location)i);
     }
 
-    int countHordesAt(Location loc) {
-        int c = 0;
-        for (auto& h : hordes) if (h.currentLocation == loc) c++;
-        return c;
+    int countHordesAt(Location loc) const override { return (int)occupants[loc].size(); }
+    // Individual zombies on the node (differs from countHordesAt in merge mode)
+    int countZombiesAt(Location loc) const override {
+        int total = 0;
+        for (int id : occupants[loc]) total += hordes[indexOfId[id]].size;
+        return total;
+    }
+    const InfectionTree& infectionTree() const { return tree; }
+
+    void removeAllHordesAt(Location loc) override {
+        vector<int> doomed;
+        for (int id : occupants[loc]) doomed.push_back(indexOfId[id]);
+        sort(doomed.rbegin(), doomed.rend());
+        for (int i : doomed) eraseHorde(i);
+    }
+
+    // Kills one zombie from the oldest horde on the node
+    void removeOneHordeAt(Location loc) override {
+        if (occupants[loc].empty()) return;
+        int i = indexOfId[occupants[loc][0]];
+        for (int id : occupants[loc]) i = min(i, indexOfId[id]);
+        if (--hordes[i].size > 0) {
+            cout << ">> [Combat] Horde " << hordes[i].id << " loses one zombie (" << hordes[i].size << " left).\n";
+            return;
+        }
+        cout << ">> [Combat] Horde " << hordes[i].id << " eliminated.\n";
+        eraseHorde(i);
+    }
+
+    bool isHordeAt(Location loc) const override { return !occupants[loc].empty(); }
+
+    // Hordes travelling the edge a-b, either way
+    int countHordesOnEdge(Location a, Location b) const { return (int)(inTransit[a][b].size() + inTransit[b][a].size()); }
+    // The player crossed a-b and ran into the hordes on it: they are pulled onto
+    // `landAt` (so the usual encounter handles the fight) and act again after a full action
+    int interceptOnEdge(Location a, Location b, Location landAt) override;
+
+    void setSeed(unsigned long long s) { seed = s; }
+    // Also wakes parked hunters next to the new spot, which they may now step onto
+    void setPlayerLocation(Location loc) override;
+    // Rolls only depend on (seed, horde id, action minute, draw), so restoring a saved
+    // horde list and the clock replays any stretch exactly without earlier history.
+    void setClock(int minute);
+    int getClock() const { return clockMinutes; }
+    static unsigned int zombieRoll(unsigned long long seed, int hordeId, int minute, int draw) {
+        return Philox4x32(seed, (unsigned int)hordeId, (unsigned int)minute, (unsigned int)draw >> 2, 0).v[draw & 3];
+    }
+    // Same seed => same result for any thread count
+    void setWorkerThreads(int n) { workerThreads = n; }
+    // Merge mode keeps one entity per (node, behaviour, speed): the horde count stays
+    // proportional to occupied nodes while size, kills and infection odds add up
+    void setMergeMode(bool on) { merging = on; if (on) mergeColocated(); }
+
+    // Runs every horde action and timer tick due in the next deltaMinutes
+    void advance(int deltaMinutes) override;
+    void simulateHour() { advance(60); }
+    // Skips `hours` without any output, reusing all scratch buffers
+    FastForwardSummary fastForward(int hours, Location playerLoc) override;
+    // Hordes within `radius` hops of the target each take one step towards it
+    void moveHordesToward(Location target, int radius = 1) override;
+    
+    private:
+    bool hasDistractionAnywhere() const { return distractionTurns.any(); }
+    Location getStepTowardsDistraction(Location start);
+    void addHorde(ZombieHorde& h);
+    void eraseHorde(int index);
+    void enterNode(int id, Location loc) { joinList(occupants[loc], id); }
+    void leaveNode(int id, Location loc) { leaveList(occupants[loc], id); }
+    void enterEdge(const ZombieHorde& h) { joinList(inTransit[h.travellingFrom][h.currentLocation], h.id); }
+    void leaveEdge(const ZombieHorde& h) { leaveList(inTransit[h.travellingFrom][h.currentLocation], h.id); }
+    void joinList(vector<int>& list, int id);
+    void leaveList(vector<int>& list, int id);
+    void mergeColocated();
+    void schedule(ZombieHorde& h);
+    bool isLive(const ScheduledAction& a) const;
+    void popAgenda();
+    void pruneAgenda();
+    void catchUpParked(ZombieHorde& h, Location loc);
+    void wakeParkedAt(Location loc);
+    void wakeHuntersAt(Location loc);
+    bool unpark(ZombieHorde& h);
+    void tickWorldTimers(int hours = 1);
+    int workerCountFor(int n) const;
+    void prepareBatch();
+    void runBatch();
+    void stepRange(int begin, int end);
+    static void stepSlice(void* self, int w);
+    template <class Policy> void stepRangeAs(int begin, int end);
+    template <class Policy> StepKind moveHordeOneStep(ZombieHorde& zombie, bool rests, unsigned int neighbourIdx);
+    void logStep(const ZombieHorde& zombie, StepKind kind);
+    void applyInfection(ZombieHorde& zombie, vector<ZombieHorde>& newHordes);
+};
+
+// =====================================================
+//              FENWICK TREE (LOOT WEIGHTS)
+// =====================================================
+// Prefix sums over a weight list: append, point update and "first index whose
+// running total passes r" are all O(log n), so loot odds can change freely.
+class FenwickTree {
+private:
+    vector<int> tree; // 1-based; tree[i] covers (i - lowbit(i), i]
+    int sum;
+
+    static int lowbit(int i) { return i & -i; }
+    int prefix(int count) const {
+        int s = 0;
+        for (int i = count; i > 0; i -= lowbit(i)) s += tree[i];
+        return s;
     }
 
-    void removeAllHordesAt(Location loc) {
-        for (int i = (int)hordes.size() - 1; i >= 0; --i) {
-            if (hordes[i].currentLocation == loc) hordes.erase(hordes.begin() + i);
+public:
+    FenwickTree() : tree(1, 0), sum(0) {}
+
+    int size() const { return (int)tree.size() - 1; }
+    int total() const { return sum; }
+
+    void push_back(int w) {
+        int i = (int)tree.size();
+        tree.push_back(w + prefix(i - 1) - prefix(i - lowbit(i)));
+        sum += w;
+    }
+
+    void add(int index, int delta) {
+        for (int i = index + 1; i < (int)tree.size(); i += lowbit(i)) tree[i] += delta;
+        sum += delta;
+    }
+
+    // Index of the first entry whose running total exceeds r, or size() if none does
+    int upperBound(int r) const {
+        int n = size();
+        int step = 1;
+        while (step * 2 <= n) step *= 2;
+        int pos = 0;
+        for (; step > 0; step /= 2) {
+            if (pos + step <= n && tree[pos + step] <= r) { pos += step; r -= tree[pos]; }
         }
+        return pos;
     }
+};
 
-    void removeOneHordeAt(Location loc) {
-        for (int i = 0; i < (int)hordes.size(); ++i) {
-            if (hordes[i].currentLocation == loc) {
-                cout << ">> [Combat] Horde " << hordes[i].id << " eliminated.\n";
-                hordes.erase(hordes.begin() + i);
-                return;
-            }
+// =====================================================
+//              LOOT RESPAWN TIMER WHEEL
+// =====================================================
+// Hierarchical timer wheel of pending loot respawns, keyed on game minutes.
+// Level 0 has one slot per minute, level 1 one per 64 minutes, level 2 one per
+// 4096; a higher slot is poured down a level when the clock reaches it. Each
+// timer is filed and fired in O(1) and idle minutes touch only one slot.
+struct LootRespawn {
+    Location loc;
+    int entry;       // index into the location's loot table
+    int basisPoints; // chance to restore along with the returning unit
+};
+
+class RespawnWheel {
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 3;
+
+    struct Timer {
+        int due;
+        int next; // next timer in the same slot, -1 ends the list
+        LootRespawn what;
+    };
+    vector<Timer> timers;
+    int freeHead;
+    int heads[LEVELS][SLOTS];
+    unsigned long long occupied[LEVELS]; // bit s set while heads[level][s] is non-empty
+    int now;
+    int pending;
+
+    // Timers due before `earliest` are filed at it
+    void file(int t, int earliest) {
+        int due = max(timers[t].due, earliest);
+        int delta = due - now;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1 << (SLOT_BITS * (level + 1)))) level++;
+        int slot = (due >> (SLOT_BITS * level)) & (SLOTS - 1);
+        timers[t].next = heads[level][slot];
+        heads[level][slot] = t;
+        occupied[level] |= 1ULL << slot;
+    }
+
+    // Next minute after `now` at which a non-empty slot fires (level 0) or cascades.
+    // Slot s of a level stands for the first block after `now` whose index ends in s.
+    int nextBusyMinute() const {
+        int best = INT_MAX;
+        for (int level = 0; level < LEVELS; level++) {
+            if (!occupied[level]) continue;
+            int shift = SLOT_BITS * level;
+            int block = (now >> shift) + 1;
+            int r = block & (SLOTS - 1);
+            unsigned long long ahead = (occupied[level] >> r) | (occupied[level] << ((SLOTS - r) & (SLOTS - 1)));
+            best = min(best, (block + __builtin_ctzll(ahead)) << shift);
         }
+        return best;
     }
 
-    bool isHordeAt(Location loc) const {
-        for (const auto& h : hordes) if (h.currentLocation == loc) return true;
-        return false;
+    // Re-files every timer of a higher-level slot; each lands at least one level lower
+    // unless it is further out than the whole wheel spans. Timers due this very
+    // minute go to the level-0 slot that is about to fire.
+    void cascade(int level) {
+        int slot = (now >> (SLOT_BITS * level)) & (SLOTS - 1);
+        int t = heads[level][slot];
+        heads[level][slot] = -1;
+        occupied[level] &= ~(1ULL << slot);
+        while (t >= 0) { int next = timers[t].next; file(t, now); t = next; }
     }
 
-    void simulateHour();
-    void moveHordesToward(Location target);
-    
-    private:
-    bool hasDistractionAnywhere();
-    Location getStepTowardsDistraction(Location start);
-    void moveHordeOneStep(ZombieHorde& zombie, vector<ZombieHorde>& newHordes);
-    void checkInfection(ZombieHorde& zombie, vector<ZombieHorde>& newHordes);
+public:
+    RespawnWheel() : freeHead(-1), now(0), pending(0) {
+        for (int l = 0; l < LEVELS; l++) {
+            occupied[l] = 0;
+            for (int s = 0; s < SLOTS; s++) heads[l][s] = -1;
+        }
+    }
+
+    int size() const { return pending; }
+
+    void schedule(int dueMinute, const LootRespawn& what) {
+        int t;
+        if (freeHead >= 0) { t = freeHead; freeHead = timers[t].next; }
+        else { t = (int)timers.size(); timers.push_back(Timer()); }
+        timers[t].due = dueMinute;
+        timers[t].what = what;
+        file(t, now + 1);
+        pending++;
+    }
+
+    // Fires every respawn due up to and including `minute`, in due order. Minutes
+    // with nothing to fire or cascade are skipped, so idle stretches cost nothing.
+    template <class OnExpire>
+    void advanceTo(int minute, OnExpire onExpire) {
+        while (now < minute) {
+            int busy = pending == 0 ? INT_MAX : nextBusyMinute();
+            if (busy > minute) { now = minute; break; }
+            now = busy;
+            for (int level = LEVELS - 1; level > 0; level--)
+                if ((now & ((1 << (SLOT_BITS * level)) - 1)) == 0) cascade(level);
+            int slot = now & (SLOTS - 1);
+            int t = heads[0][slot];
+            heads[0][slot] = -1;
+            occupied[0] &= ~(1ULL << slot);
+            while (t >= 0) {
+                int next = timers[t].next;
+                if (timers[t].due <= now) {
+                    onExpire(timers[t].what);
+                    timers[t].next = freeHead;
+                    freeHead = t;
+                    pending--;
+                } else {
+                    file(t, now + 1);
+                }
+                t = next;
+            }
+        }
+    }
+};
+
+// =====================================================
+//              DEFAULT LOOT TABLES
+// =====================================================
+// Scavenge odds in basis points (1/10000). Each location's entries must add up
+// to at most 10000 and list an item at most once; the rest is "nothing". Stock
+// is how many units can be found there, each at the same odds.
+struct LootEntry {
+    Location loc;
+    ItemId item;
+    int basisPoints;
+    int stock;
+};
+
+constexpr LootEntry DEFAULT_LOOT[] = {
+    { HOME, ITEM_BREAD, 2500, 1 }, { HOME, ITEM_PILLS, 1500, 1 }, { HOME, ITEM_APPLE, 1500, 1 },
+    { HOME, ITEM_USER_ID, 3500, 1 }, { HOME, ITEM_CAR_KEYS, 200, 1 },
+    { PETROL_STATION, ITEM_PETROL, 6000, 3 }, { PETROL_STATION, ITEM_CLOTH, 2000, 1 }, { PETROL_STATION, ITEM_JUNK, 1000, 1 },
+    { PARK, ITEM_APPLE, 2500, 1 }, { PARK, ITEM_ENERGY_DRINK, 1500, 1 }, { PARK, ITEM_TWIG, 1500, 1 }, { PARK, ITEM_PEBBLE, 3500, 1 },
+    { BUS_STOP, ITEM_PEBBLE, 7000, 1 }, { BUS_STOP, ITEM_JUNK, 1500, 1 },
+    { OFFICE, ITEM_PILLS, 2000, 1 }, { OFFICE, ITEM_USER_ID, 4000, 1 }, { OFFICE, ITEM_JUNK, 3000, 1 },
+    { STORE, ITEM_BREAD, 2000, 1 }, { STORE, ITEM_APPLE, 1500, 1 }, { STORE, ITEM_ENERGY_DRINK, 1500, 1 }, { STORE, ITEM_AXE, 3500, 1 }, { STORE, ITEM_JUNK, 1000, 1 },
+    { SCHOOL, ITEM_APPLE, 1500, 1 }, { SCHOOL, ITEM_BACKPACK, 3000, 1 }, { SCHOOL, ITEM_JUNK, 2000, 1 }, { SCHOOL, ITEM_BOOK, 2500, 1 },
+    { TOWN_HALL, ITEM_BREAD, 4000, 1 }, { TOWN_HALL, ITEM_CLOTH, 2500, 1 }, { TOWN_HALL, ITEM_PEBBLE, 2000, 1 },
+    { CAFE, ITEM_ENERGY_DRINK, 4500, 1 }, { CAFE, ITEM_BREAD, 4500, 1 },
+    { POLICE_STATION, ITEM_GUN, 5000, 1 }, { POLICE_STATION, ITEM_AMMO, 2500, 1 }, { POLICE_STATION, ITEM_ENERGY_DRINK, 1500, 1 },
+    { HOSPITAL, ITEM_APPLE, 2000, 1 }, { HOSPITAL, ITEM_CLOTH, 3000, 1 }, { HOSPITAL, ITEM_FIRST_AID, 4000, 1 },
+    { LAB, ITEM_PIN, 6000, 1 }, { LAB, ITEM_AMMO, 1500, 1 }, { LAB, ITEM_FIRST_AID, 1500, 1 }, { LAB, ITEM_PEBBLE, 1000, 1 },
+    { BRIDGE, ITEM_PEBBLE, 2500, 1 }, { BRIDGE, ITEM_TWIG, 2000, 1 }, { BRIDGE, ITEM_AMMO, 1500, 1 }, { BRIDGE, ITEM_FIRST_AID, 3000, 1 },
+};
+constexpr int DEFAULT_LOOT_COUNT = sizeof(DEFAULT_LOOT) / sizeof(DEFAULT_LOOT[0]);
+
+// Single-return recursion keeps these valid C++11 constexpr functions
+
+constexpr int lootSumAt(int loc, int i) {
+    return i == DEFAULT_LOOT_COUNT ? 0
+         : (DEFAULT_LOOT[i].loc == loc ? DEFAULT_LOOT[i].basisPoints : 0) + lootSumAt(loc, i + 1);
+}
+
+constexpr bool lootEntriesSane(int i) {
+    return i == DEFAULT_LOOT_COUNT ||
+           (DEFAULT_LOOT[i].basisPoints >= 0 && DEFAULT_LOOT[i].stock >= 1 && lootEntriesSane(i + 1));
+}
+
+constexpr bool lootOddsWithinRange(int loc = 0) {
+    return loc == COUNT || (lootSumAt(loc, 0) <= 10000 && lootOddsWithinRange(loc + 1));
+}
+
+constexpr bool lootDuplicates(int i, int j) {
+    return j < DEFAULT_LOOT_COUNT &&
+           ((DEFAULT_LOOT[i].loc == DEFAULT_LOOT[j].loc && DEFAULT_LOOT[i].item == DEFAULT_LOOT[j].item) ||
+            lootDuplicates(i, j + 1));
+}
+
+constexpr bool lootHasNoDuplicates(int i = 0) {
+    return i == DEFAULT_LOOT_COUNT || (!lootDuplicates(i, i + 1) && lootHasNoDuplicates(i + 1));
+}
+
+static_assert(lootEntriesSane(0), "a loot entry has negative odds or no stock");
+static_assert(lootOddsWithinRange(), "a location's loot odds add up to more than 100%");
+static_assert(lootHasNoDuplicates(), "an item is listed twice in one location's loot table");
+
+// Everyday supplies restock this many minutes after a unit is taken. Anything
+// not listed (keys, ID, PIN, weapons, Petrol...) is gone for good once found.
+struct RespawnEntry {
+    ItemId item;
+    int minutes;
+};
+
+constexpr RespawnEntry DEFAULT_RESPAWN[] = {
+    { ITEM_BREAD, 6 * 60 }, { ITEM_APPLE, 4 * 60 }, { ITEM_PILLS, 12 * 60 }, { ITEM_ENERGY_DRINK, 8 * 60 },
+    { ITEM_CLOTH, 8 * 60 }, { ITEM_JUNK, 3 * 60 }, { ITEM_PEBBLE, 2 * 60 }, { ITEM_TWIG, 2 * 60 },
 };
 
 // =====================================================
@@ -462,18 +1216,26 @@ public:
 class MapGraph {
 private:
     Node* adj[COUNT];
+    NodePool<Node> edgePool; // adjacency nodes live as long as the map
     vector<ItemProb> itemTable[COUNT];
+    FenwickTree lootWeights[COUNT]; // running totals of itemTable[loc] basis points
+    bool lootLoaded[COUNT];         // itemTable[loc] filled from DEFAULT_LOOT yet
+    int respawnMinutes[ITEM_COUNT]; // 0: a picked-up item never comes back
+    RespawnWheel respawns;
+    int lootClock;                  // game minute the respawns have been run up to
     bool bridgeUnlocked;
 
 public:
     MapGraph() {
-        for (int i = 0; i < COUNT; i++) adj[i] = NULL;
+        for (int i = 0; i < COUNT; i++) { adj[i] = NULL; lootLoaded[i] = false; }
+        for (int i = 0; i < ITEM_COUNT; i++) respawnMinutes[i] = 0;
+        for (const RespawnEntry& r : DEFAULT_RESPAWN) respawnMinutes[r.item] = r.minutes;
+        lootClock = 0;
         bridgeUnlocked = false;
         buildDefaultMap();
-        initItemProbabilities();
     }
 
-    void addEdge(Location a, Location b) {
+    void addEdge(Location a, Location b, int travelMinutes = 0) {
         // Prevent duplicates
         Node* temp = adj[a];
         while (temp) {
@@ -482,14 +1244,14 @@ public:
         }
 
         int u = a, v = b;
-        Node* newNode = new Node(v);
+        Node* newNode = edgePool.create(v, travelMinutes);
         newNode->next = adj[u]; adj[u] = newNode;
-        Node* newNode2 = new Node(u);
+        Node* newNode2 = edgePool.create(u, travelMinutes);
         newNode2->next = adj[v]; adj[v] = newNode2;
     }
 
     // --- VISUAL MAP DISPLAY ---
-    void displayVisualMap(Player& p, ZombieSystem& zsys) {
+    void displayVisualMap(Player& p, ZombieBackend& zsys) {
         clearScreen();
         printHeader("TACTICAL MAP VIEW");
 
@@ -565,21 +1327,76 @@ public:
         return true;
     }
 
+    // Odds are laid out on a 0-10000 scale in table order; a roll past the
+    // last entry finds nothing.
     ItemProb* scavenge(Location loc) {
-        double sum = 0;
-        for (auto& ip : itemTable[loc]) sum += ip.probability;
-        int roll = rand() % 100;
-        double cumulative = 0;
-        for (auto& ip : itemTable[loc]) {
-            cumulative += ip.probability;
-            if (roll < cumulative) return &ip;
-        }
-        return nullptr;
+        loadLoot(loc);
+        int roll = rollBasisPoints();
+        int pick = lootWeights[loc].upperBound(roll);
+        if (pick >= (int)itemTable[loc].size()) return nullptr;
+        return &itemTable[loc][pick];
     }
 
-    void removeItemChance(Location loc, ItemProb* item) {
+    void setItemChance(Location loc, ItemProb* item, int basisPoints) {
         if (!item) return;
-        item->probability = 0;
+        lootWeights[loc].add((int)(item - &itemTable[loc][0]), basisPoints - item->basisPoints);
+        item->basisPoints = basisPoints;
+    }
+
+    // Taking an item uses up one unit of its stock there; the chance drops to 0
+    // with the last one. If the item respawns, the unit (and the chance, if it
+    // had run out) comes back respawnMinutes later.
+    void removeItemChance(Location loc, ItemProb* item) {
+        if (!item || item->stock <= 0) return;
+        int wait = respawnMinutes[item->item];
+        if (wait > 0 && item->basisPoints > 0)
+            respawns.schedule(lootClock + wait, { loc, (int)(item - &itemTable[loc][0]), item->basisPoints });
+        if (--item->stock == 0) setItemChance(loc, item, 0);
+    }
+
+    void setRespawnMinutes(ItemId item, int minutes) { respawnMinutes[item] = minutes; }
+    void setRespawnMinutes(int minutes) { for (int i = 0; i < ITEM_COUNT; i++) respawnMinutes[i] = minutes; }
+    int pendingRespawns() const { return respawns.size(); }
+
+    // Brings loot up to the player's clock, restoring everything whose respawn is due
+    void advanceLootClock(int minute) {
+        if (minute <= lootClock) return;
+        lootClock = minute;
+        respawns.advanceTo(minute, [this](const LootRespawn& r) {
+            ItemProb& ip = itemTable[r.loc][r.entry];
+            ip.stock++;
+            if (ip.basisPoints == 0) setItemChance(r.loc, &ip, r.basisPoints);
+        });
+    }
+
+    // Current basis-point chance that one scavenge at loc turns up `item`
+    int itemChance(Location loc, ItemId item) const {
+        int bp = 0;
+        if (lootLoaded[loc]) {
+            for (const ItemProb& ip : itemTable[loc]) if (ip.item == item) bp += ip.basisPoints;
+        } else {
+            for (const LootEntry& e : DEFAULT_LOOT) if (e.loc == loc && e.item == item) bp += e.basisPoints;
+        }
+        return bp;
+    }
+
+    // Fewest moves from a to b over open edges, -1 if b can't be reached
+    int hopsBetween(Location a, Location b) const {
+        int distance[COUNT];
+        for (int i = 0; i < COUNT; i++) distance[i] = -1;
+        queue<Location> q;
+        q.push(a);
+        distance[a] = 0;
+        while (!q.empty()) {
+            Location u = q.front(); q.pop();
+            if (u == b) return distance[u];
+            for (Node* n = adj[u]; n; n = n->next) {
+                if (distance[n->vertex] >= 0) continue;
+                distance[n->vertex] = distance[u] + 1;
+                q.push((Location)n->vertex);
+            }
+        }
+        return -1;
     }
 
     void unlockBridgeToSafeZone() {
@@ -629,29 +1446,87 @@ private:
         addEdge(LAB, BRIDGE);
     }
 
-    void addItem(Location loc, const string& name, double prob) {
-        itemTable[loc].push_back({ name, prob });
+    void addItem(Location loc, ItemId item, int basisPoints, int stock = 1) {
+        itemTable[loc].push_back({ item, basisPoints, stock });
+        lootWeights[loc].push_back(basisPoints);
+    }
+
+    // Uniform in 0..9999. rand() % 10000 would favour low rolls whenever RAND_MAX + 1
+    // isn't a multiple of 10000 (MSVC's 32767 makes 0-2767 a third likelier), so
+    // draws from the incomplete block at the top are thrown away.
+    static int rollBasisPoints() {
+        const int limit = RAND_MAX - RAND_MAX % 10000;
+        int r;
+        do { r = rand(); } while (r >= limit);
+        return r % 10000;
     }
 
-    void initItemProbabilities() {
-        addItem(HOME, "Bread", 25); addItem(HOME, "Pills", 15); addItem(HOME, "Apple", 15);
-        addItem(HOME, "User ID", 35); addItem(HOME, "Car Keys", 2);
-        addItem(PETROL_STATION, "Petrol", 60); addItem(PETROL_STATION, "Petrol", 60); addItem(PETROL_STATION, "Petrol", 60); 
-        addItem(PETROL_STATION, "Cloth", 20); addItem(PETROL_STATION, "Junk", 10);
-        addItem(PARK, "Apple", 25); addItem(PARK, "Energy Drink", 15); addItem(PARK, "Twig", 15); addItem(PARK, "Pebble", 35);
-        addItem(BUS_STOP, "Pebble", 70); addItem(BUS_STOP, "Junk", 15);
-        addItem(OFFICE, "Pills", 20); addItem(OFFICE, "User ID", 40); addItem(OFFICE, "Junk", 30);
-        addItem(STORE, "Bread", 20); addItem(STORE, "Apple", 15); addItem(STORE, "Energy Drink", 15); addItem(STORE, "Axe", 35); addItem(STORE, "Junk", 10);
-        addItem(SCHOOL, "Apple", 15); addItem(SCHOOL, "Backpack", 30); addItem(SCHOOL, "Junk", 20); addItem(SCHOOL, "Book", 25);
-        addItem(TOWN_HALL, "Bread", 40); addItem(TOWN_HALL, "Cloth", 25); addItem(TOWN_HALL, "Pebble", 20);
-        addItem(CAFE, "Energy Drink", 45); addItem(CAFE, "Bread", 45); 
-        addItem(POLICE_STATION, "Gun", 50); addItem(POLICE_STATION, "Ammo", 25); addItem(POLICE_STATION, "Energy Drink", 15);
-        addItem(HOSPITAL, "Apple", 20); addItem(HOSPITAL, "Cloth", 30); addItem(HOSPITAL, "First Aid", 40);
-        addItem(LAB, "PIN", 60); addItem(LAB, "Ammo", 15); addItem(LAB, "First Aid", 15); addItem(LAB, "Pebble", 10);
-        addItem(BRIDGE, "Pebble", 25); addItem(BRIDGE, "Twig", 20); addItem(BRIDGE, "Ammo", 15); addItem(BRIDGE, "First Aid", 30);
+    // Copies the location's rows of DEFAULT_LOOT on first use
+    void loadLoot(Location loc) {
+        if (lootLoaded[loc]) return;
+        lootLoaded[loc] = true;
+        for (const LootEntry& e : DEFAULT_LOOT)
+            if (e.loc == loc) addItem(loc, e.item, e.basisPoints, e.stock);
     }
 };
 
+// =====================================================
+//              TIME-TO-ITEM ESTIMATOR
+// =====================================================
+// Each scavenge is an independent draw that finds item i with chance p_i, and
+// picking an item up only turns its share into "nothing". So the number of
+// scavenges T to find every item of a set S at one stop has
+//   P(T > n) = sum over non-empty J in S of (-1)^(|J|+1) (1 - P_J)^n,  P_J = sum of p_i in J
+// which sums to  E[T] = sum (-1)^(|J|+1) / P_J  and  E[T^2] = sum (-1)^(|J|+1) (2 - P_J) / P_J^2.
+// A single item is the plain geometric case: 1/p and (1-p)/p^2.
+struct CollectEstimate {
+    bool possible;            // every wanted item can drop somewhere on the route
+    double expectedScavenges;
+    double expectedMinutes;   // moves plus scavenges
+    double varianceMinutes;   // moves are fixed, so this is all scavenge time
+};
+
+// Walks `route` in order (route[0] is where the player starts) and at each stop
+// scavenges until it has every still-missing wanted item that can drop there.
+CollectEstimate estimateCollectTime(const MapGraph& map, ItemMask wanted, const vector<Location>& route,
+                                    int moveMinutes = 60, int scavengeMinutes = 30) {
+    CollectEstimate est = { true, 0, 0, 0 };
+    ItemMask missing = wanted;
+    for (size_t stop = 0; stop < route.size(); stop++) {
+        if (stop > 0) {
+            int hops = map.hopsBetween(route[stop - 1], route[stop]);
+            if (hops < 0) { est.possible = false; return est; }
+            est.expectedMinutes += (double)hops * moveMinutes;
+        }
+
+        double p[ITEM_COUNT];
+        int k = 0;
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            if (!(missing & itemBit((ItemId)i))) continue;
+            int bp = map.itemChance(route[stop], (ItemId)i);
+            if (bp <= 0) continue;
+            p[k++] = bp / 10000.0;
+            missing &= ~itemBit((ItemId)i);
+        }
+        if (k == 0) continue;
+
+        double mean = 0, secondMoment = 0;
+        for (unsigned int subset = 1; subset < (1u << k); subset++) {
+            double pj = 0;
+            int bits = 0;
+            for (int i = 0; i < k; i++) if (subset & (1u << i)) { pj += p[i]; bits++; }
+            double sign = (bits % 2) ? 1.0 : -1.0;
+            mean += sign / pj;
+            secondMoment += sign * (2.0 - pj) / (pj * pj);
+        }
+        est.expectedScavenges += mean;
+        est.expectedMinutes += mean * scavengeMinutes;
+        est.varianceMinutes += (secondMoment - mean * mean) * scavengeMinutes * scavengeMinutes;
+    }
+    if (missing) est.possible = false;
+    return est;
+}
+
 // =====================================================
 //          ZOMBIE SYSTEM IMPLEMENTATION
 // =====================================================
@@ -659,31 +1534,40 @@ ZombieSystem::ZombieSystem(MapGraph* m) {
     map = m;
     nextId = 1;
     for (int i = 0; i < COUNT; ++i) {
-        junkBlocks[i] = 0;
-        distractionTurns[i] = 0;
         infected[i] = false;
     }
-    infectionRoot = nullptr;
-}
-
-bool ZombieSystem::hasDistractionAnywhere() {
-    for(int i=0; i<COUNT; i++) if(distractionTurns[i] > 0) return true;
-    return false;
+    seed = ((unsigned long long)rand() << 32) ^ (unsigned long long)rand();
+    workerThreads = 0;
+    playerLocation = COUNT;
+    clockMinutes = 0;
+    for (int i = 0; i < COUNT; ++i) {
+        lastMeetingMinute[i] = -1;
+        listedParked[i] = false;
+    }
+    anyDistraction = false;
+    batchWorkers = 1;
+    quiet = false;
+    merging = false;
+    infectionCount = 0;
+    spawnCount = 0;
 }
 
-Location ZombieSystem::getStepTowardsDistraction(Location start) {
+// BFS from start to the nearest distracted node, returns the first step on that path.
+// Shared by the per-horde and the aggregate zombie backends.
+Location stepTowardsDistraction(MapGraph* map, const LocationTimers& distractionTurns, Location start) {
     if (distractionTurns[start] > 0) return start;
     int distance[COUNT];
     int parent[COUNT];
     bool visited[COUNT];
     for(int i=0; i<COUNT; i++) { distance[i] = 9999; visited[i] = false; parent[i] = -1; }
-    queue<Location> q;
-    q.push(start);
+    Location q[COUNT]; // every node is queued at most once
+    int head = 0, tail = 0;
+    q[tail++] = start;
     visited[start] = true;
     distance[start] = 0;
     Location targetFound = COUNT;
-    while(!q.empty()) {
-        Location u = q.front(); q.pop();
+    while(head < tail) {
+        Location u = q[head++];
         if (distractionTurns[u] > 0) { targetFound = u; break; }
         Node* n = map->getNeighbors(u);
         while(n) {
@@ -692,7 +1576,7 @@ Location ZombieSystem::getStepTowardsDistraction(Location start) {
                 visited[v] = true;
                 distance[v] = distance[u] + 1;
                 parent[v] = u;
-                q.push(v);
+                q[tail++] = v;
             }
             n = n->next;
         }
@@ -703,114 +1587,911 @@ Location ZombieSystem::getStepTowardsDistraction(Location start) {
     return curr;
 }
 
-void ZombieSystem::simulateHour() {
-    cout << "\n--- ZOMBIES MOVE (1 HOUR) ---\n";
-    vector<ZombieHorde> newHordes;
+Location ZombieSystem::getStepTowardsDistraction(Location start) {
+    return stepTowardsDistraction(map, distractionTurns, start);
+}
+
+void ZombieSystem::addHorde(ZombieHorde& h) {
+    if ((int)indexOfId.size() <= h.id) indexOfId.resize(h.id + 1, -1);
+    indexOfId[h.id] = (int)hordes.size();
+    if (h.travellingFrom == COUNT) enterNode(h.id, h.currentLocation);
+    else enterEdge(h);
+    h.nextActionMinute = clockMinutes + h.minutesPerAction;
+    hordes.push_back(h);
+    schedule(hordes.back());
+}
+
+void ZombieSystem::eraseHorde(int index) {
+    if (hordes[index].travellingFrom == COUNT) leaveNode(hordes[index].id, hordes[index].currentLocation);
+    else leaveEdge(hordes[index]);
+    indexOfId[hordes[index].id] = -1;
+    hordes.erase(hordes.begin() + index);
+    for (int i = index; i < (int)hordes.size(); i++) indexOfId[hordes[i].id] = i;
+}
+
+void ZombieSystem::joinList(vector<int>& list, int id) {
+    if ((int)slotOfId.size() <= id) slotOfId.resize(id + 1, -1);
+    slotOfId[id] = (int)list.size();
+    list.push_back(id);
+}
+
+// Swap-remove: the last entry takes over the leaving horde's slot
+void ZombieSystem::leaveList(vector<int>& list, int id) {
+    int slot = slotOfId[id], last = list.back();
+    list[slot] = last;
+    slotOfId[last] = slot;
+    list.pop_back();
+    slotOfId[id] = -1;
+}
+
+int ZombieSystem::interceptOnEdge(Location a, Location b, Location landAt) {
+    vector<int> caught(inTransit[a][b]);
+    caught.insert(caught.end(), inTransit[b][a].begin(), inTransit[b][a].end());
+    if (caught.empty()) return 0;
+    cout << ">> [Road] " << caught.size() << " horde(s) were on the road between " << locationToString(a)
+         << " and " << locationToString(b) << "!\n";
+    for (int id : caught) {
+        ZombieHorde& h = hordes[indexOfId[id]];
+        unpark(h);
+        leaveEdge(h);
+        h.travellingFrom = COUNT;
+        h.currentLocation = landAt;
+        enterNode(h.id, landAt);
+        h.nextActionMinute = clockMinutes + h.minutesPerAction; // the pending arrival goes stale
+        schedule(h);
+    }
+    return (int)caught.size();
+}
+
+void ZombieSystem::schedule(ZombieHorde& h) {
+    h.parked = false;
+    if (agenda.size() >= 2 * hordes.size() + 64) pruneAgenda();
+    agenda.push_back({ h.nextActionMinute, h.id });
+    push_heap(agenda.begin(), agenda.end(), greater<ScheduledAction>());
+}
+
+// Entries for killed, parked or rescheduled hordes are left in the heap and skipped
+bool ZombieSystem::isLive(const ScheduledAction& a) const {
+    int idx = a.hordeId < (int)indexOfId.size() ? indexOfId[a.hordeId] : -1;
+    return idx >= 0 && !hordes[idx].parked && hordes[idx].nextActionMinute == a.minute;
+}
+
+void ZombieSystem::popAgenda() {
+    pop_heap(agenda.begin(), agenda.end(), greater<ScheduledAction>());
+    agenda.pop_back();
+}
+
+// Drops the stale entries in place, so reschedules can't grow the heap without bound
+void ZombieSystem::pruneAgenda() {
+    agenda.erase(remove_if(agenda.begin(), agenda.end(),
+                           [this](const ScheduledAction& a) { return !isLive(a); }), agenda.end());
+    make_heap(agenda.begin(), agenda.end(), greater<ScheduledAction>());
+}
+
+void ZombieSystem::setClock(int minute) {
+    clockMinutes = minute;
+    agenda.clear();
+    for (int i = 0; i < COUNT; i++) {
+        occupants[i].clear();
+        parkedAt[i].clear();
+        for (int j = 0; j < COUNT; j++) inTransit[i][j].clear();
+    }
     for (auto& h : hordes) {
-        moveHordeOneStep(h, newHordes);
+        if (h.travellingFrom == COUNT) enterNode(h.id, h.currentLocation);
+        else enterEdge(h);
+        if (h.nextActionMinute <= minute) h.nextActionMinute = minute + h.minutesPerAction;
+        schedule(h);
     }
-    for (auto& nh : newHordes) {
-        hordes.push_back(nh);
+}
+
+// A parked horde skipped actions while blocked at `loc`. Each one would only have
+// added +2 (or been reset to 5 by a meeting), so apply them in one go and move
+// nextActionMinute past the clock. The caller puts it back on the agenda.
+void ZombieSystem::catchUpParked(ZombieHorde& h, Location loc) {
+    int missed = (clockMinutes - h.nextActionMinute) / h.minutesPerAction + 1;
+    if (h.nextActionMinute > clockMinutes) missed = 0;
+    int lastMissed = h.nextActionMinute + (missed - 1) * h.minutesPerAction;
+    if (missed > 0 && lastMeetingMinute[loc] >= h.nextActionMinute) {
+        int sinceMeeting = (lastMissed - lastMeetingMinute[loc]) / h.minutesPerAction;
+        h.infectionRate = 5 + 2 * sinceMeeting;
+    } else {
+        h.infectionRate += 2 * missed;
     }
-    int countAt[COUNT] = { 0 };
-    for (auto& h : hordes) countAt[h.currentLocation]++;
-    for (auto& h : hordes) {
-        if (countAt[h.currentLocation] > 1) h.infectionRate = 5; 
+    if (h.infectionRate > 100) h.infectionRate = 100;
+    h.nextActionMinute += missed * h.minutesPerAction;
+}
+
+void ZombieSystem::wakeParkedAt(Location loc) {
+    for (int id : parkedAt[loc]) {
+        int idx = indexOfId[id];
+        if (idx < 0 || !hordes[idx].parked) continue;
+        catchUpParked(hordes[idx], loc);
+        schedule(hordes[idx]);
     }
-    for (int i = 0; i < COUNT; ++i) {
-        if (junkBlocks[i] > 0) junkBlocks[i]--;
-        if (distractionTurns[i] > 0) distractionTurns[i]--;
+    parkedAt[loc].clear();
+}
+
+// Wakes only the PLAYER_HUNTER hordes parked at loc; the rest stay parked
+void ZombieSystem::wakeHuntersAt(Location loc) {
+    vector<int>& list = parkedAt[loc];
+    for (size_t k = 0; k < list.size();) {
+        int idx = indexOfId[list[k]];
+        bool live = idx >= 0 && hordes[idx].parked;
+        if (live && hordes[idx].behaviour != PLAYER_HUNTER) { k++; continue; }
+        if (live) {
+            catchUpParked(hordes[idx], loc);
+            schedule(hordes[idx]);
+        }
+        list[k] = list.back();
+        list.pop_back();
     }
 }
 
-void ZombieSystem::moveHordesToward(Location target) {
-    cout << ">> [Scent] The wind shifts... Zombies smell you.\n";
-    for (auto& zombie : hordes) {
-        if (distractionTurns[zombie.currentLocation] > 0 || hasDistractionAnywhere()) {
-            continue; 
+void ZombieSystem::setPlayerLocation(Location loc) {
+    if (loc == playerLocation) return;
+    playerLocation = loc;
+    if (loc == COUNT) return;
+    for (Node* t = map->getNeighbors(loc); t; t = t->next) wakeHuntersAt((Location)t->vertex);
+}
+
+// For moves that are not the horde's own action (scent, interception): drops the
+// parking record at the node it is leaving and catches up the skipped actions, as
+// a wake there would. Returns whether it was parked, i.e. still off the agenda.
+bool ZombieSystem::unpark(ZombieHorde& h) {
+    if (!h.parked) return false;
+    vector<int>& list = parkedAt[h.currentLocation];
+    vector<int>::iterator it = find(list.begin(), list.end(), h.id);
+    if (it != list.end()) list.erase(it);
+    catchUpParked(h, h.currentLocation);
+    h.parked = false;
+    return true;
+}
+
+// Runs `hours` hourly ticks ending at clockMinutes. Only the last may expire Junk
+// (see advance), and nothing moves in between, so the meeting record is the same.
+void ZombieSystem::tickWorldTimers(int hours) {
+    // Nodes whose parked list has emptied are dropped from parkedNodes here
+    for (size_t k = 0; k < parkedNodes.size();) {
+        Location loc = parkedNodes[k];
+        if (parkedAt[loc].empty()) {
+            listedParked[loc] = false;
+            parkedNodes[k] = parkedNodes.back();
+            parkedNodes.pop_back();
+            continue;
         }
-        if (zombie.currentLocation == target) continue;
-        Node* temp = map->getNeighbors(zombie.currentLocation);
-        while (temp) {
-            Location neigh = (Location)temp->vertex;
-            if (neigh == target && junkBlocks[neigh] == 0) {
-                zombie.currentLocation = target;
-                zombie.infectionRate += 2;
-                if (zombie.infectionRate > 100) zombie.infectionRate = 100;
-                cout << "   ! [Horde " << zombie.id << "] rushes to your location! (Infection: " << zombie.infectionRate << "%)\n";
+        if (occupants[loc].size() > 1) lastMeetingMinute[loc] = clockMinutes;
+        k++;
+    }
+    // A node opened up again: hordes stuck next to it can move
+    junkBlocks.tick(hours, [this](Location loc) {
+        for (Node* t = map->getNeighbors(loc); t; t = t->next) wakeParkedAt((Location)t->vertex);
+    });
+    distractionTurns.tick(hours);
+}
+
+FastForwardSummary ZombieSystem::fastForward(int hours, Location playerLoc) {
+    int infectionsBefore = infectionCount, spawnsBefore = spawnCount;
+    setPlayerLocation(playerLoc);
+    quiet = true;
+    advance(hours * 60);
+    quiet = false;
+    FastForwardSummary summary;
+    summary.infections = infectionCount - infectionsBefore;
+    summary.spawns = spawnCount - spawnsBefore;
+    summary.hordesAtPlayer = countHordesAt(playerLoc);
+    return summary;
+}
+
+void ZombieSystem::advance(int deltaMinutes) {
+    int target = clockMinutes + deltaMinutes;
+    while (true) {
+        int nextHour = (clockMinutes / 60 + 1) * 60;
+        while (!agenda.empty() && !isLive(agenda.front())) popAgenda();
+        int next = nextHour;
+        if (!agenda.empty() && agenda.front().minute < next) next = agenda.front().minute;
+        if (next > target) break;
+        // No horde acts before the next agenda entry and only a Junk expiry can wake a
+        // parked one, so the hours up to the earlier of the two are ticked in one go
+        if (agenda.empty() || agenda.front().minute > next) {
+            int until = agenda.empty() ? target : min(target, agenda.front().minute - 1);
+            int hours = (until - next) / 60 + 1;
+            if (junkBlocks.any()) hours = min(hours, junkBlocks.soonest());
+            clockMinutes = next + (hours - 1) * 60;
+            tickWorldTimers(hours);
+            continue;
+        }
+        clockMinutes = next;
+
+        due.clear();
+        while (!agenda.empty() && agenda.front().minute == next) {
+            if (isLive(agenda.front())) due.push_back(indexOfId[agenda.front().hordeId]);
+            popAgenda();
+        }
+        if (!due.empty()) runBatch();
+        if (next == nextHour) tickWorldTimers();
+    }
+    clockMinutes = target;
+}
+
+int ZombieSystem::workerCountFor(int n) const {
+    if (workerThreads > 0) return max(1, min(workerThreads, n));
+    int w = (int)thread::hardware_concurrency();
+    return max(1, min(w, n / MIN_HORDES_PER_WORKER));
+}
+
+// Neighbour lists and distraction steps are per node, not per horde: build them once
+void ZombieSystem::prepareBatch() {
+    anyDistraction = hasDistractionAnywhere();
+    for (int i = 0; i < COUNT; i++) {
+        openNeighbors[i].clear();
+        for (Node* t = map->getNeighbors((Location)i); t; t = t->next) {
+            if (junkBlocks[t->vertex] == 0) openNeighbors[i].push_back((Location)t->vertex);
+        }
+        distractionStep[i] = anyDistraction ? getStepTowardsDistraction((Location)i) : (Location)i;
+        hunterStep[i] = (Location)i;
+        for (int j = 0; j < COUNT; j++) travelMinutes[i][j] = 0;
+        for (Node* t = map->getNeighbors((Location)i); t; t = t->next) travelMinutes[i][t->vertex] = t->minutes;
+    }
+    // One BFS out from the player gives every node its next step towards them.
+    // Hunters route around Junk; the player's own node is always a valid goal.
+    if (typeStart[PLAYER_HUNTER + 1] == typeStart[PLAYER_HUNTER] || playerLocation == COUNT) return;
+    bool seen[COUNT] = { false };
+    Location q[COUNT]; // every node is queued at most once
+    int head = 0, tail = 0;
+    q[tail++] = playerLocation;
+    seen[playerLocation] = true;
+    while (head < tail) {
+        Location u = q[head++];
+        if (u != playerLocation && junkBlocks[u] > 0) continue;
+        for (Node* t = map->getNeighbors(u); t; t = t->next) {
+            if (seen[t->vertex]) continue;
+            seen[t->vertex] = true;
+            hunterStep[t->vertex] = u;
+            q[tail++] = (Location)t->vertex;
+        }
+    }
+}
+
+// Steps every horde in `due` at clockMinutes
+void ZombieSystem::runBatch() {
+    if (!quiet) cout << "\n--- ZOMBIES MOVE ---\n";
+    sort(due.begin(), due.end());
+    int n = (int)due.size();
+    stepKinds.assign(n, STEP_BLOCKED);
+    claimed.assign(n, 0);
+    dueFrom.resize(n);
+    for (int p = 0; p < n; p++) dueFrom[p] = hordes[due[p]].currentLocation;
+
+    // Type-sorted dispatch: a stable counting sort groups the positions by behaviour
+    int fill[BEHAVIOUR_COUNT];
+    for (int b = 0; b <= BEHAVIOUR_COUNT; b++) typeStart[b] = 0;
+    for (int p = 0; p < n; p++) typeStart[hordes[due[p]].behaviour + 1]++;
+    for (int b = 0; b < BEHAVIOUR_COUNT; b++) { typeStart[b + 1] += typeStart[b]; fill[b] = typeStart[b]; }
+    stepOrder.resize(n);
+    for (int p = 0; p < n; p++) stepOrder[fill[hordes[due[p]].behaviour]++] = p;
+    prepareBatch();
+
+    // Each worker owns a contiguous slice of stepOrder
+    batchWorkers = workerCountFor(n);
+    if (batchWorkers == 1) stepRange(0, n);
+    else pool.run(batchWorkers, &ZombieSystem::stepSlice, this);
+
+    // Merge in horde-index order: the lowest index to claim a node infects it
+    spawned.clear();
+    for (int p = 0; p < n; p++) {
+        ZombieHorde& h = hordes[due[p]];
+        if (stepKinds[p] == STEP_DEPART) {
+            leaveNode(h.id, dueFrom[p]);
+            enterEdge(h);
+        } else if (stepKinds[p] == STEP_ARRIVE) {
+            leaveEdge(h);
+            h.travellingFrom = COUNT;
+            enterNode(h.id, h.currentLocation);
+        } else if (h.currentLocation != dueFrom[p]) {
+            leaveNode(h.id, dueFrom[p]);
+            enterNode(h.id, h.currentLocation);
+        }
+        if (!quiet) logStep(h, (StepKind)stepKinds[p]);
+        if (claimed[p] && !infected[h.currentLocation]) applyInfection(h, spawned);
+    }
+
+    // Meeting rule, then back on the agenda (or parked if boxed in by Junk)
+    for (int p = 0; p < n; p++) {
+        ZombieHorde& h = hordes[due[p]];
+        if (stepKinds[p] == STEP_DEPART) {
+            // Nothing to do on the road: the next wake-up is the arrival
+            h.nextActionMinute = clockMinutes + travelMinutes[dueFrom[p]][h.currentLocation];
+            schedule(h);
+            continue;
+        }
+        if (occupants[h.currentLocation].size() > 1) h.infectionRate = 5;
+        h.nextActionMinute = clockMinutes + h.minutesPerAction;
+        if (stepKinds[p] == STEP_BLOCKED) {
+            h.parked = true;
+            parkedAt[h.currentLocation].push_back(h.id);
+            if (!listedParked[h.currentLocation]) {
+                listedParked[h.currentLocation] = true;
+                parkedNodes.push_back(h.currentLocation);
+            }
+        } else {
+            schedule(h);
+        }
+    }
+    for (auto& nh : spawned) {
+        addHorde(nh);
+        spawnCount++;
+    }
+    if (merging) mergeColocated();
+}
+
+// Compatible hordes (same behaviour and speed) on a node fuse into the oldest one.
+// Parked hordes are left alone; they rejoin once they wake. Absorbed hordes are
+// compacted out in one pass, their agenda entries go stale and are skipped.
+void ZombieSystem::mergeColocated() {
+    bool absorbedAny = false;
+    vector<int>& keep = mergeKeep;
+    for (int i = 0; i < COUNT; i++) {
+        if (occupants[i].size() < 2) continue;
+        keep.clear();
+        for (int id : occupants[i]) {
+            int idx = indexOfId[id];
+            if (hordes[idx].parked) continue;
+            size_t g = 0;
+            while (g < keep.size() && (hordes[keep[g]].behaviour != hordes[idx].behaviour ||
+                                       hordes[keep[g]].minutesPerAction != hordes[idx].minutesPerAction)) g++;
+            if (g == keep.size()) keep.push_back(idx);
+            else if (idx < keep[g]) keep[g] = idx;
+        }
+        for (int id : occupants[i]) {
+            int idx = indexOfId[id];
+            if (hordes[idx].parked) continue;
+            for (int k : keep) {
+                if (k == idx || hordes[k].behaviour != hordes[idx].behaviour ||
+                    hordes[k].minutesPerAction != hordes[idx].minutesPerAction) continue;
+                hordes[k].size += hordes[idx].size;
+                hordes[k].infectionRate = 5; // a meeting, as in the unmerged rule
+                hordes[idx].size = 0;
+                absorbedAny = true;
                 break;
             }
-            temp = temp->next;
         }
     }
+    if (!absorbedAny) return;
+
+    size_t out = 0;
+    for (size_t i = 0; i < hordes.size(); i++) {
+        if (hordes[i].size == 0) {
+            leaveNode(hordes[i].id, hordes[i].currentLocation);
+            indexOfId[hordes[i].id] = -1;
+            continue;
+        }
+        if (out != i) hordes[out] = hordes[i];
+        indexOfId[hordes[out].id] = (int)out;
+        out++;
+    }
+    hordes.erase(hordes.begin() + out, hordes.end());
 }
 
-void ZombieSystem::moveHordeOneStep(ZombieHorde& zombie, vector<ZombieHorde>& newHordes) {
-    if (distractionTurns[zombie.currentLocation] > 0) {
-        cout << "   - [Horde " << zombie.id << "] is distracted by noise at " << locationToString(zombie.currentLocation) << ".\n";
-        return;
+// Splits a slice of stepOrder at behaviour boundaries: one switch per run of
+// same-behaviour hordes instead of one branch per horde
+void ZombieSystem::stepSlice(void* self, int w) {
+    ZombieSystem* z = (ZombieSystem*)self;
+    long long n = (long long)z->due.size();
+    z->stepRange((int)(n * w / z->batchWorkers), (int)(n * (w + 1) / z->batchWorkers));
+}
+
+void ZombieSystem::stepRange(int begin, int end) {
+    for (int b = 0; b < BEHAVIOUR_COUNT; b++) {
+        int lo = max(begin, typeStart[b]), hi = min(end, typeStart[b + 1]);
+        if (lo >= hi) continue;
+        switch (b) {
+        case DISTRACTION_SEEKER: stepRangeAs<DistractionSeeker>(lo, hi); break;
+        case RANDOM_WALK:        stepRangeAs<RandomWalk>(lo, hi); break;
+        case PLAYER_HUNTER:      stepRangeAs<PlayerHunter>(lo, hi); break;
+        case STATIONARY:         stepRangeAs<Stationary>(lo, hi); break;
+        }
+    }
+}
+
+// Steps hordes ROLL_LANES at a time: the rolls come from one batched kernel call,
+// the moves are applied per horde, then the infection test is one batched compare.
+// Only flags infection claims; whether a claim wins is decided in the merge.
+template <class Policy>
+void ZombieSystem::stepRangeAs(int begin, int end) {
+    unsigned int ids[ROLL_LANES], degrees[ROLL_LANES], neighbourIdx[ROLL_LANES], infectRoll[ROLL_LANES];
+    int rates[ROLL_LANES];
+    int pos[ROLL_LANES];
+    for (int base = begin; base < end; base += ROLL_LANES) {
+        int lanes = min(ROLL_LANES, end - base);
+        for (int l = 0; l < ROLL_LANES; l++) {
+            pos[l] = l < lanes ? stepOrder[base + l] : 0;
+            ids[l] = l < lanes ? (unsigned int)hordes[due[pos[l]]].id : 0;
+            degrees[l] = l < lanes ? (unsigned int)openNeighbors[hordes[due[pos[l]]].currentLocation].size() : 0;
+        }
+        // Stationary hordes never move or infect, so they need no rolls at all
+        unsigned int restMask = 0;
+        if (Policy::moves) restMask = hordeRollKernel(seed, (unsigned int)clockMinutes, ids, degrees, neighbourIdx, infectRoll);
+
+        unsigned int candidates = 0;
+        for (int l = 0; l < ROLL_LANES; l++) {
+            rates[l] = 0;
+            if (l >= lanes) continue;
+            ZombieHorde& zombie = hordes[due[pos[l]]];
+            StepKind kind;
+            if (zombie.travellingFrom != COUNT) {
+                kind = STEP_ARRIVE; // this wake-up is the end of a long edge
+            } else {
+                kind = moveHordeOneStep<Policy>(zombie, (restMask >> l) & 1, neighbourIdx[l]);
+                Location from = dueFrom[pos[l]];
+                if (zombie.currentLocation != from && travelMinutes[from][zombie.currentLocation] > 0) {
+                    zombie.travellingFrom = from; // infects on arrival, not now
+                    kind = STEP_DEPART;
+                }
+            }
+            stepKinds[pos[l]] = (unsigned char)kind;
+            if ((kind == STEP_TO_NOISE || kind == STEP_SHAMBLE || kind == STEP_TO_PLAYER || kind == STEP_ARRIVE) &&
+                !infected[zombie.currentLocation]) {
+                candidates |= 1u << l;
+                rates[l] = zombie.effectiveInfectionRate();
+            }
+        }
+        if (!candidates) continue;
+
+        unsigned int hits = infectCompareKernel(infectRoll, rates) & candidates;
+        for (int l = 0; l < lanes; l++) {
+            if ((hits >> l) & 1) claimed[pos[l]] = 1;
+        }
+    }
+}
+
+// Bounded BFS out from the target, then only the hordes on the nodes it reached are
+// visited through the occupancy index. Scent does not pass through Junk, but a horde
+// standing on a Junk node can still leave it.
+void ZombieSystem::moveHordesToward(Location target, int radius) {
+    cout << ">> [Scent] The wind shifts... Zombies smell you.\n";
+    if (hasDistractionAnywhere() || junkBlocks[target] > 0) return;
+    int distance[COUNT];
+    Location towards[COUNT]; // next step back to the target
+    for (int i = 0; i < COUNT; i++) distance[i] = -1;
+    vector<Location> reached(1, target);
+    distance[target] = 0;
+    for (size_t k = 0; k < reached.size(); k++) {
+        Location u = reached[k];
+        if (distance[u] == radius || (u != target && junkBlocks[u] > 0)) continue;
+        for (Node* t = map->getNeighbors(u); t; t = t->next) {
+            Location v = (Location)t->vertex;
+            if (distance[v] >= 0) continue;
+            distance[v] = distance[u] + 1;
+            towards[v] = u;
+            reached.push_back(v);
+        }
+    }
+
+    // Pick everyone first so nobody moves twice, then move in horde order
+    vector<int> movers;
+    for (size_t k = 1; k < reached.size(); k++) {
+        for (int id : occupants[reached[k]]) movers.push_back(indexOfId[id]);
+    }
+    sort(movers.begin(), movers.end());
+    for (int i : movers) {
+        ZombieHorde& zombie = hordes[i];
+        Location step = towards[zombie.currentLocation];
+        bool wasParked = unpark(zombie);
+        leaveNode(zombie.id, zombie.currentLocation);
+        enterNode(zombie.id, step);
+        zombie.currentLocation = step;
+        if (wasParked) schedule(zombie);
+        zombie.infectionRate += 2;
+        if (zombie.infectionRate > 100) zombie.infectionRate = 100;
+        if (step == target) {
+            cout << "   ! [Horde " << zombie.id << "] rushes to your location! (Infection: " << zombie.infectionRate << "%)\n";
+        } else {
+            cout << "   ! [Horde " << zombie.id << "] follows your scent to " << locationToString(step) << ". (Infection: " << zombie.infectionRate << "%)\n";
+        }
     }
-    if (hasDistractionAnywhere()) {
-        Location step = getStepTowardsDistraction(zombie.currentLocation);
+}
+
+// Runs on a worker thread: touches only this horde. The Policy switches are
+// compile-time constants, so each instantiation keeps only its own rules.
+template <class Policy>
+ZombieSystem::StepKind ZombieSystem::moveHordeOneStep(ZombieHorde& zombie, bool rests, unsigned int neighbourIdx) {
+    if (Policy::followsNoise && distractionTurns[zombie.currentLocation] > 0) return STEP_DISTRACTED;
+    if (Policy::followsNoise && anyDistraction) {
+        Location step = distractionStep[zombie.currentLocation];
         if (step != zombie.currentLocation) {
             if (junkBlocks[step] == 0) {
                 zombie.currentLocation = step;
-                cout << "   - [Horde " << zombie.id << "] moves towards noise at " << locationToString(step) << ".\n";
-                checkInfection(zombie, newHordes);
-                return; 
+                return STEP_TO_NOISE; 
             }
         }
     }
     zombie.infectionRate += 2; 
     if (zombie.infectionRate > 100) zombie.infectionRate = 100;
 
-    int roll = rand() % 100;
-    if (roll < 15) {
+    if (!Policy::moves || rests) return STEP_RESTING;
+    if (Policy::huntsPlayer) {
+        Location step = hunterStep[zombie.currentLocation];
+        if (zombie.currentLocation == playerLocation) return STEP_RESTING; // already on you
+        // Junk does not keep a hunter off the player's own node
+        if (step != zombie.currentLocation && (step == playerLocation || junkBlocks[step] == 0)) {
+            zombie.currentLocation = step;
+            return STEP_TO_PLAYER;
+        }
+    }
+    const vector<Location>& neighbors = openNeighbors[zombie.currentLocation];
+    if (neighbors.empty()) return STEP_BLOCKED;
+    zombie.currentLocation = neighbors[neighbourIdx];
+    return STEP_SHAMBLE;
+}
+
+void ZombieSystem::logStep(const ZombieHorde& zombie, StepKind kind) {
+    switch (kind) {
+    case STEP_DISTRACTED:
+        cout << "   - [Horde " << zombie.id << "] is distracted by noise at " << locationToString(zombie.currentLocation) << ".\n";
+        break;
+    case STEP_TO_NOISE:
+        cout << "   - [Horde " << zombie.id << "] moves towards noise at " << locationToString(zombie.currentLocation) << ".\n";
+        break;
+    case STEP_RESTING:
         cout << "   - [Horde " << zombie.id << "] is resting at " << locationToString(zombie.currentLocation) << " (Inf: " << zombie.infectionRate << "%).\n";
-        return;
+        break;
+    case STEP_DEPART:
+        cout << "   - [Horde " << zombie.id << "] sets off for " << locationToString(zombie.currentLocation) << ".\n";
+        break;
+    case STEP_ARRIVE:
+        cout << "   - [Horde " << zombie.id << "] arrives at " << locationToString(zombie.currentLocation) << " (Inf: " << zombie.infectionRate << "%).\n";
+        break;
+    case STEP_TO_PLAYER:
+        cout << "   - [Horde " << zombie.id << "] stalks you to " << locationToString(zombie.currentLocation) << " (Inf: " << zombie.infectionRate << "%).\n";
+        break;
+    case STEP_SHAMBLE:
+        cout << "   - [Horde " << zombie.id << "] shambles to " << locationToString(zombie.currentLocation) << " (Inf: " << zombie.infectionRate << "%).\n";
+        break;
+    default:
+        break;
+    }
+}
+
+void ZombieSystem::applyInfection(ZombieHorde& zombie, vector<ZombieHorde>& newHordes) {
+    if (!quiet) cout << "     >> " << locationToString(zombie.currentLocation) << " HAS BEEN INFECTED!\n";
+    infected[zombie.currentLocation] = true;
+    infectionCount++;
+    zombie.infectionRate = 5;
+    int child = tree.addChild(zombie.treeNode, zombie.currentLocation, clockMinutes);
+    ZombieHorde splitHorde(nextId++, zombie.currentLocation, 5, child, zombie.minutesPerAction, zombie.behaviour);
+    newHordes.push_back(splitHorde);
+    if (!quiet) cout << "     >> WARNING: A new horde has spawned!\n";
+}
+
+// =====================================================
+//          AGGREGATE ZOMBIE SYSTEM (POPULATION COUNTS)
+// =====================================================
+// Alternative backend for city-scale outbreaks. Instead of one ZombieHorde per
+// horde it keeps a count per (location, infectionRate), so an hour costs
+// O(COUNT * RATE_BUCKETS * degree) no matter how many hordes exist.
+// Rules are the same as ZombieSystem::simulateHour:
+//  - rest (15%) and the uniform non-Junk neighbour pick are multinomial splits
+//  - infection of a node is decided by binomial draws over every horde arriving there
+// Individual ids and the infection tree are not tracked in this mode, and moves
+// are instant, so nothing is ever caught on an edge.
+class AggregateZombieSystem : public ZombieBackend {
+private:
+    static const int RATE_BUCKETS = 101; // infectionRate 0..100
+    long long pop[COUNT][RATE_BUCKETS];
+    long long arrivals[COUNT][RATE_BUCKETS];
+    LocationTimers junkBlocks;
+    LocationTimers distractionTurns;
+    bool infected[COUNT];
+    MapGraph* map;
+    mt19937 rng;
+    int pendingMinutes; // advanced but not yet a whole hour
+    bool quiet;         // fastForward: no log output
+    int infectionCount;
+    int spawnCount;
+
+public:
+    AggregateZombieSystem(MapGraph* m);
+
+    void addInitialHorde(Location loc) override { addHordes(loc, 1, 5); }
+
+    void addHordes(Location loc, long long count, int rate) {
+        if (count <= 0) return;
+        pop[loc][clampRate(rate)] += count;
+        infected[loc] = true;
+    }
+
+    void applyJunk(Location loc) override {
+        junkBlocks.set(loc, 2);
+        cout << ">> [Junk] The path is blocked. Zombies will be repelled for 2 turns.\n";
+    }
+
+    void applyDistraction(Location loc, int duration) override {
+        distractionTurns.set(loc, duration);
+        announceDistraction(loc, duration);
+    }
+
+    long long populationAt(Location loc) const {
+        long long c = 0;
+        for (int r = 0; r < RATE_BUCKETS; r++) c += pop[loc][r];
+        return c;
+    }
+
+    long long totalHordes() const {
+        long long c = 0;
+        for (int i = 0; i < COUNT; i++) c += populationAt((Location)i);
+        return c;
+    }
+
+    // The game counts in int; a city-scale node saturates rather than wrapping
+    int countHordesAt(Location loc) const override {
+        long long c = populationAt(loc);
+        return c > INT_MAX ? INT_MAX : (int)c;
+    }
+    int countZombiesAt(Location loc) const override { return countHordesAt(loc); }
+
+    bool isHordeAt(Location loc) const override { return populationAt(loc) > 0; }
+    bool isInfected(Location loc) const { return infected[loc]; }
+
+    void removeAllHordesAt(Location loc) override {
+        for (int r = 0; r < RATE_BUCKETS; r++) pop[loc][r] = 0;
+    }
+
+    void removeOneHordeAt(Location loc) override {
+        for (int r = 0; r < RATE_BUCKETS; r++) {
+            if (pop[loc][r] > 0) {
+                pop[loc][r]--;
+                long long left = populationAt(loc);
+                if (left > 0) cout << ">> [Combat] A horde is eliminated (" << left << " left here).\n";
+                else cout << ">> [Combat] The last horde here is eliminated.\n";
+                return;
+            }
+        }
+    }
+
+    int interceptOnEdge(Location, Location, Location) override { return 0; }
+    void setPlayerLocation(Location) override {} // no player hunters in this mode
+
+    // Runs one simulateHour per whole hour of game time
+    void advance(int deltaMinutes) override {
+        pendingMinutes += deltaMinutes;
+        while (pendingMinutes >= 60) { pendingMinutes -= 60; simulateHour(); }
+    }
+
+    FastForwardSummary fastForward(int hours, Location playerLoc) override {
+        int infectionsBefore = infectionCount, spawnsBefore = spawnCount;
+        quiet = true;
+        advance(hours * 60);
+        quiet = false;
+        FastForwardSummary summary;
+        summary.infections = infectionCount - infectionsBefore;
+        summary.spawns = spawnCount - spawnsBefore;
+        summary.hordesAtPlayer = countHordesAt(playerLoc);
+        return summary;
+    }
+
+    void simulateHour();
+    void moveHordesToward(Location target, int radius = 1) override;
+
+private:
+    static int clampRate(int r) { return r < 0 ? 0 : (r > 100 ? 100 : r); }
+    bool hasDistractionAnywhere() const { return distractionTurns.any(); }
+    long long binomial(long long n, double p);
+    void resolveInfection(Location loc);
+};
+
+AggregateZombieSystem::AggregateZombieSystem(MapGraph* m) : rng((unsigned)rand()) {
+    map = m;
+    pendingMinutes = 0;
+    quiet = false;
+    infectionCount = 0;
+    spawnCount = 0;
+    for (int i = 0; i < COUNT; ++i) {
+        for (int r = 0; r < RATE_BUCKETS; r++) pop[i][r] = arrivals[i][r] = 0;
+        infected[i] = false;
+    }
+}
+
+long long AggregateZombieSystem::binomial(long long n, double p) {
+    if (n <= 0 || p <= 0) return 0;
+    if (p >= 1) return n;
+    binomial_distribution<long long> dist(n, p);
+    return dist(rng);
+}
+
+void AggregateZombieSystem::simulateHour() {
+    if (!quiet) cout << "\n--- ZOMBIES MOVE (1 HOUR) ---\n";
+    long long next[COUNT][RATE_BUCKETS] = { { 0 } };
+    bool distracted = hasDistractionAnywhere();
+
+    for (int i = 0; i < COUNT; i++) {
+        Location loc = (Location)i;
+
+        // Non-Junk neighbours are the same for every horde on this node
+        Location open[COUNT];
+        int openCount = 0;
+        for (Node* t = map->getNeighbors(loc); t; t = t->next) {
+            if (junkBlocks[t->vertex] == 0) open[openCount++] = (Location)t->vertex;
+        }
+        Location step = distracted ? stepTowardsDistraction(map, distractionTurns, loc) : loc;
+
+        for (int r = 0; r < RATE_BUCKETS; r++) {
+            long long n = pop[i][r];
+            if (n == 0) continue;
+
+            // Distracted here: nobody moves, nothing changes
+            if (distractionTurns[loc] > 0) { next[i][r] += n; continue; }
+            // Distraction elsewhere: everyone takes the same BFS step
+            if (step != loc && junkBlocks[step] == 0) { arrivals[step][r] += n; continue; }
+
+            int r2 = clampRate(r + 2);
+            long long resting = binomial(n, 0.15);
+            next[i][r2] += resting;
+            long long moving = n - resting;
+            if (openCount == 0) { next[i][r2] += moving; continue; }
+
+            // Uniform multinomial over open neighbours as a chain of binomials
+            for (int k = 0; k < openCount && moving > 0; k++) {
+                long long c = (k == openCount - 1) ? moving : binomial(moving, 1.0 / (openCount - k));
+                arrivals[open[k]][r2] += c;
+                moving -= c;
+            }
+        }
+    }
+
+    for (int i = 0; i < COUNT; i++) {
+        if (!infected[i]) resolveInfection((Location)i);
+        for (int r = 0; r < RATE_BUCKETS; r++) {
+            next[i][r] += arrivals[i][r];
+            arrivals[i][r] = 0;
+        }
+    }
+
+    // Meeting rule: several hordes on one node all drop back to 5%
+    for (int i = 0; i < COUNT; i++) {
+        long long total = 0;
+        for (int r = 0; r < RATE_BUCKETS; r++) total += next[i][r];
+        for (int r = 0; r < RATE_BUCKETS; r++) pop[i][r] = next[i][r];
+        if (total > 1) {
+            for (int r = 0; r < RATE_BUCKETS; r++) pop[i][r] = 0;
+            pop[i][5] = total;
+        }
+    }
+
+    junkBlocks.tick();
+    distractionTurns.tick();
+}
+
+// Every horde arriving at an uninfected node rolls once; the first success (in a
+// random arrival order) infects it. Successes per bucket are binomial, and the
+// infecting horde is a uniform pick among all successes.
+void AggregateZombieSystem::resolveInfection(Location loc) {
+    long long successes[RATE_BUCKETS];
+    long long total = 0;
+    for (int r = 0; r < RATE_BUCKETS; r++) {
+        successes[r] = binomial(arrivals[loc][r], r / 100.0);
+        total += successes[r];
+    }
+    if (total == 0) return;
+
+    long long pick = uniform_int_distribution<long long>(0, total - 1)(rng);
+    int bucket = 0;
+    while (pick >= successes[bucket]) pick -= successes[bucket++];
+
+    infected[loc] = true;
+    arrivals[loc][bucket]--;
+    arrivals[loc][5] += 2; // infecting horde resets to 5% and splits
+    infectionCount++;
+    spawnCount++;
+    if (quiet) return;
+    cout << "     >> " << locationToString(loc) << " HAS BEEN INFECTED!\n";
+    cout << "     >> WARNING: A new horde has spawned!\n";
+}
+
+// Same reach as ZombieSystem::moveHordesToward: a bounded BFS that scent does not
+// pass through Junk, then everyone reached takes one step back towards the target
+void AggregateZombieSystem::moveHordesToward(Location target, int radius) {
+    cout << ">> [Scent] The wind shifts... Zombies smell you.\n";
+    if (hasDistractionAnywhere() || junkBlocks[target] > 0) return;
+    int distance[COUNT];
+    Location towards[COUNT];
+    for (int i = 0; i < COUNT; i++) distance[i] = -1;
+    vector<Location> reached(1, target);
+    distance[target] = 0;
+    for (size_t k = 0; k < reached.size(); k++) {
+        Location u = reached[k];
+        if (distance[u] == radius || (u != target && junkBlocks[u] > 0)) continue;
+        for (Node* t = map->getNeighbors(u); t; t = t->next) {
+            Location v = (Location)t->vertex;
+            if (distance[v] >= 0) continue;
+            distance[v] = distance[u] + 1;
+            towards[v] = u;
+            reached.push_back(v);
+        }
+    }
+    // Arrivals go through `arrivals` so nobody moves twice
+    for (size_t k = 1; k < reached.size(); k++) {
+        Location from = reached[k];
+        for (int r = 0; r < RATE_BUCKETS; r++) {
+            if (pop[from][r] == 0) continue;
+            arrivals[towards[from]][clampRate(r + 2)] += pop[from][r];
+            pop[from][r] = 0;
+        }
     }
-    vector<Location> neighbors;
-    Node* temp = map->getNeighbors(zombie.currentLocation);
-    while (temp) {
-        Location neigh = (Location)temp->vertex;
-        if (junkBlocks[neigh] == 0) neighbors.push_back(neigh);
-        temp = temp->next;
-    }
-    if (neighbors.empty()) return;
-    int idx = rand() % neighbors.size();
-    Location newLoc = neighbors[idx];
-    zombie.currentLocation = newLoc;
-    cout << "   - [Horde " << zombie.id << "] shambles to " << locationToString(newLoc) << " (Inf: " << zombie.infectionRate << "%).\n";
-    checkInfection(zombie, newHordes);
-}
-
-void ZombieSystem::checkInfection(ZombieHorde& zombie, vector<ZombieHorde>& newHordes) {
-    if (!infected[zombie.currentLocation]) {
-        int infectRoll = rand() % 100;
-        if (infectRoll < zombie.infectionRate) {
-            cout << "     >> " << locationToString(zombie.currentLocation) << " HAS BEEN INFECTED!\n";
-            infected[zombie.currentLocation] = true;
-            zombie.infectionRate = 5;
-            InfectionNode* child = new InfectionNode(zombie.currentLocation);
-            if (!zombie.treeNode->left) zombie.treeNode->left = child;
-            else if (!zombie.treeNode->right) zombie.treeNode->right = child;
-            ZombieHorde splitHorde(nextId++, zombie.currentLocation, 5, child);
-            newHordes.push_back(splitHorde);
-            cout << "     >> WARNING: A new horde has spawned!\n";
+    for (size_t k = 0; k < reached.size(); k++) {
+        for (int r = 0; r < RATE_BUCKETS; r++) {
+            pop[reached[k]][r] += arrivals[reached[k]][r];
+            arrivals[reached[k]][r] = 0;
         }
     }
 }
 
 // =====================================================
-// GLOBAL ACTIONS IMPLEMENTATION
+//              ITEM DEFINITIONS
 // =====================================================
+// What [U]se does for each item, indexed by ItemId. The menu makes one indexed
+// call; a new item needs a row here and, only if no existing effect fits, a use function.
+struct ItemUse {
+    Player& player;
+    Inventory& inv;
+    MapGraph& map;
+    ZombieBackend& zsys;
+    bool& playerAlive;
+    ItemId item;
+};
+typedef void (*ItemUseFn)(ItemUse& use);
+
+struct ItemDef {
+    ItemId id;           // must match the row's index
+    ItemUseFn use;       // NULL: nothing to do from the menu, print `hint`
+    int hpGain;
+    int staminaGain;
+    int duration;        // boost/bandage minutes, or zombie turns for a distraction
+    int overdosePercent; // death chance when taken while a speed boost is running
+    const char* hint;
+};
 
-void advanceZombies(ZombieSystem& zsys, int& zombieMinuteBuffer, int deltaMinutes) {
-    zombieMinuteBuffer += deltaMinutes;
-    while (zombieMinuteBuffer >= 60) {
-        zsys.simulateHour();
-        zombieMinuteBuffer -= 60;
+const ItemDef ITEM_DEFS[ITEM_COUNT] = {
+    { ITEM_BREAD, [](ItemUse& u) { useFood(u.player, u.inv, u.item, ITEM_DEFS[u.item].hpGain); }, 15, 0, 0, 0, NULL },
+    { ITEM_APPLE, [](ItemUse& u) { useFood(u.player, u.inv, u.item, ITEM_DEFS[u.item].hpGain); }, 5, 0, 0, 0, NULL },
+    { ITEM_PILLS, [](ItemUse& u) { usePills(u.player, u.inv, u.playerAlive); }, 0, 50, 60, 60, NULL },
+    { ITEM_ENERGY_DRINK, [](ItemUse& u) { useEnergyDrink(u.player, u.inv, u.playerAlive); }, 0, 50, 30, 50, NULL },
+    { ITEM_CLOTH, [](ItemUse& u) { useCloth(u.player, u.inv); }, 0, 0, 120, 0, NULL },
+    { ITEM_FIRST_AID, NULL, 0, 0, 0, 0, "Cannot use here." },
+    { ITEM_JUNK, [](ItemUse& u) { useJunkAtCurrentNode(u.player, u.inv, u.zsys); }, 0, 0, 0, 0, NULL },
+    { ITEM_PEBBLE, [](ItemUse& u) { usePebble(u.player, u.inv, u.map, u.zsys); }, 0, 0, 2, 0, NULL },
+    { ITEM_TWIG, [](ItemUse& u) { useTwig(u.player, u.inv, u.map, u.zsys); }, 0, 0, 1, 0, NULL },
+    { ITEM_AXE, [](ItemUse& u) { useAxeOnBridge(u.map, u.player, u.inv); }, 0, 0, 0, 0, NULL },
+    { ITEM_GUN, NULL, 0, 0, 0, 0, "Equip automatically during combat. Keep Ammo handy!" },
+    { ITEM_AMMO, NULL, 0, 0, 0, 0, "Used automatically with Gun during combat." },
+    { ITEM_BACKPACK, NULL, 0, 0, 0, 0, "Cannot use here." },
+    { ITEM_BOOK, NULL, 0, 0, 0, 0, "Cannot use here." },
+    { ITEM_PETROL, NULL, 0, 0, 0, 0, "Use at Home to escape via Car." },
+    { ITEM_CAR_KEYS, NULL, 0, 0, 0, 0, "Use at Home to escape via Car." },
+    { ITEM_USER_ID, NULL, 0, 0, 0, 0, "Use at Safe Zone to win." },
+    { ITEM_PIN, NULL, 0, 0, 0, 0, "Use at Safe Zone to win." },
+};
+
+// A row out of place would silently give one item another's effect
+static bool checkItemDefs() {
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        if (ITEM_DEFS[i].id != i) {
+            cerr << "ITEM_DEFS row " << i << " is " << itemToString(ITEM_DEFS[i].id) << ", expected "
+                 << itemToString((ItemId)i) << "\n";
+            abort();
+        }
     }
+    return true;
+}
+static const bool itemDefsChecked = checkItemDefs();
+
+// =====================================================
+// GLOBAL ACTIONS IMPLEMENTATION
+// =====================================================
+
+// The zombie scheduler keeps its own clock; hordes act whenever their next action falls inside deltaMinutes
+void advanceZombies(ZombieBackend& zsys, const Player& player, int deltaMinutes) {
+    zsys.setPlayerLocation(player.currentLocation);
+    zsys.advance(deltaMinutes);
 }
 
 void applyTimeToPlayer(Player& player, int deltaMinutes, bool& playerAlive) {
@@ -832,16 +2513,16 @@ void applyTimeToPlayer(Player& player, int deltaMinutes, bool& playerAlive) {
     }
 }
 
-void useJunkAtCurrentNode(Player& player, Inventory& inv, ZombieSystem& zsys) {
-    if (inv.consumeOne("Junk")) {
+void useJunkAtCurrentNode(Player& player, Inventory& inv, ZombieBackend& zsys) {
+    if (inv.consumeOne(ITEM_JUNK)) {
         zsys.applyJunk(player.currentLocation);
     } else {
         cout << ">> You don't have any Junk.\n";
     }
 }
 
-void usePebble(Player& player, Inventory& inv, MapGraph& map, ZombieSystem& zsys) {
-    if (!inv.consumeOne("Pebble")) { cout << ">> You don't have a pebble.\n"; return; }
+void usePebble(Player& player, Inventory& inv, MapGraph& map, ZombieBackend& zsys) {
+    if (!inv.consumeOne(ITEM_PEBBLE)) { cout << ">> You don't have a pebble.\n"; return; }
     cout << "\n[Targeting] Where do you want to throw the pebble?\n";
     vector<Location> targets;
     targets.push_back(player.currentLocation);
@@ -854,11 +2535,11 @@ void usePebble(Player& player, Inventory& inv, MapGraph& map, ZombieSystem& zsys
     }
     int choice; cout << "Enter choice: "; cin >> choice;
     if (choice < 1 || choice > (int)targets.size()) { cout << ">> Wasted.\n"; return; }
-    zsys.applyDistraction(targets[choice - 1], 2);
+    zsys.applyDistraction(targets[choice - 1], ITEM_DEFS[ITEM_PEBBLE].duration);
 }
 
-void useTwig(Player& player, Inventory& inv, MapGraph& map, ZombieSystem& zsys) {
-    if (!inv.consumeOne("Twig")) { cout << ">> You don't have a twig.\n"; return; }
+void useTwig(Player& player, Inventory& inv, MapGraph& map, ZombieBackend& zsys) {
+    if (!inv.consumeOne(ITEM_TWIG)) { cout << ">> You don't have a twig.\n"; return; }
     cout << "\n[Targeting] Where do you want to snap the twig?\n";
     vector<Location> targets;
     targets.push_back(player.currentLocation);
@@ -871,79 +2552,83 @@ void useTwig(Player& player, Inventory& inv, MapGraph& map, ZombieSystem& zsys)
     }
     int choice; cout << "Enter choice: "; cin >> choice;
     if (choice < 1 || choice > (int)targets.size()) { cout << ">> Wasted.\n"; return; }
-    zsys.applyDistraction(targets[choice - 1], 1);
+    zsys.applyDistraction(targets[choice - 1], ITEM_DEFS[ITEM_TWIG].duration);
 }
 
 void useEnergyDrink(Player& player, Inventory& inv, bool& playerAlive) {
-    if (!inv.consumeOne("Energy Drink")) { cout << "None left.\n"; return; }
+    if (!inv.consumeOne(ITEM_ENERGY_DRINK)) { cout << "None left.\n"; return; }
+    const ItemDef& def = ITEM_DEFS[ITEM_ENERGY_DRINK];
     bool risk = (player.speedBoostTimer > 0);
-    player.stamina += 50; if (player.stamina > 100) player.stamina = 100;
-    player.speedBoostTimer += 30;
-    cout << ">> [Energy Drink] Gulp. Speed Boost +30m.\n";
+    player.stamina += def.staminaGain; if (player.stamina > 100) player.stamina = 100;
+    player.speedBoostTimer += def.duration;
+    cout << ">> [Energy Drink] Gulp. Speed Boost +" << def.duration << "m.\n";
     if (risk) {
-        if (rand() % 100 < 50) { cout << ">>> OVERDOSE! You die.\n"; playerAlive = false; }
+        if (rand() % 100 < def.overdosePercent) { cout << ">>> OVERDOSE! You die.\n"; playerAlive = false; }
         else cout << ">>> Dizzy, but alive.\n";
     }
 }
 
 void usePills(Player& player, Inventory& inv, bool& playerAlive) {
-    if (!inv.consumeOne("Pills")) { cout << "None left.\n"; return; }
+    if (!inv.consumeOne(ITEM_PILLS)) { cout << "None left.\n"; return; }
+    const ItemDef& def = ITEM_DEFS[ITEM_PILLS];
     bool risk = (player.speedBoostTimer > 0);
-    player.stamina += 50; if (player.stamina > 100) player.stamina = 100;
-    player.speedBoostTimer += 60;
-    cout << ">> [Pills] Swallowed. Speed Boost +60m.\n";
+    player.stamina += def.staminaGain; if (player.stamina > 100) player.stamina = 100;
+    player.speedBoostTimer += def.duration;
+    cout << ">> [Pills] Swallowed. Speed Boost +" << def.duration << "m.\n";
     if (risk) {
-        if (rand() % 100 < 60) { cout << ">>> OVERDOSE! You die.\n"; playerAlive = false; }
+        if (rand() % 100 < def.overdosePercent) { cout << ">>> OVERDOSE! You die.\n"; playerAlive = false; }
         else { cout << ">>> CRASH! Stamina drained.\n"; player.stamina = 0; player.speedBoostTimer = 0; }
     }
 }
 
-void useFood(Player& player, Inventory& inv, string itemName, int hpGain) {
-    if (!inv.consumeOne(itemName)) { cout << ">> You don't have " << itemName << ".\n"; return; }
+void useFood(Player& player, Inventory& inv, ItemId item, int hpGain) {
+    if (!inv.consumeOne(item)) { cout << ">> You don't have " << itemToString(item) << ".\n"; return; }
     player.hp += hpGain;
     if (player.hp > 100) player.hp = 100;
-    cout << ">> [Food] You eat the " << itemName << ". HP +" << hpGain << " (Current: " << player.hp << ").\n";
+    cout << ">> [Food] You eat the " << itemToString(item) << ". HP +" << hpGain << " (Current: " << player.hp << ").\n";
 }
 
 void useCloth(Player& player, Inventory& inv) {
-    if (!inv.consumeOne("Cloth")) { cout << "None left.\n"; return; }
-    player.clothEffectMinutesLeft = 120;
-    cout << ">> [Cloth] Wounds bandaged (protected for 2 hrs).\n";
+    if (!inv.consumeOne(ITEM_CLOTH)) { cout << "None left.\n"; return; }
+    player.clothEffectMinutesLeft = ITEM_DEFS[ITEM_CLOTH].duration;
+    cout << ">> [Cloth] Wounds bandaged (protected for " << ITEM_DEFS[ITEM_CLOTH].duration / 60 << " hrs).\n";
 }
 
 void useAxeOnBridge(MapGraph& map, Player& player, Inventory& inv) {
     if (player.currentLocation != BRIDGE) { cout << ">> Must be at Bridge.\n"; return; }
     if (map.isBridgeOpen()) { cout << ">> Already open.\n"; return; }
-    if (!inv.consumeOne("Axe")) { cout << ">> No Axe.\n"; return; }
+    if (!inv.consumeOne(ITEM_AXE)) { cout << ">> No Axe.\n"; return; }
     map.unlockBridgeToSafeZone();
 }
 
-void resolveZombieEncounter(Player& player, Inventory& inv, ZombieSystem& zsys, bool& playerAlive);
-void useGunOnZombies(Player& player, Inventory& inv, ZombieSystem& zsys, bool& playerAlive) {
-    if (!inv.contains("Gun")) { cout << ">> No Gun!\n"; return; }
-    int hordes = zsys.countHordesAt(player.currentLocation);
-    if (hordes == 0) { cout << ">> No zombies here.\n"; return; }
-    int ammo = inv.countItem("Ammo");
+void resolveZombieEncounter(Player& player, Inventory& inv, ZombieBackend& zsys, bool& playerAlive);
+void useGunOnZombies(Player& player, Inventory& inv, ZombieBackend& zsys, bool& playerAlive) {
+    if (!inv.contains(ITEM_GUN)) { cout << ">> No Gun!\n"; return; }
+    int zombies = zsys.countZombiesAt(player.currentLocation); // one bullet each, merged hordes included
+    if (zombies == 0) { cout << ">> No zombies here.\n"; return; }
+    int ammo = inv.countItem(ITEM_AMMO);
     if (ammo == 0) { cout << ">> No Ammo!\n"; return; }
-    cout << ">> Targets: " << hordes << " | Ammo: " << ammo << ".\n";
-    if (ammo >= hordes) {
-        inv.consumeMany("Ammo", hordes);
+    cout << ">> Targets: " << zombies << " | Ammo: " << ammo << ".\n";
+    if (ammo >= zombies) {
+        inv.consumeMany(ITEM_AMMO, zombies);
         zsys.removeAllHordesAt(player.currentLocation);
         cout << ">> [Gun] All zombies dead.\n";
     } else {
-        inv.consumeOne("Ammo");
+        inv.consumeOne(ITEM_AMMO);
         zsys.removeOneHordeAt(player.currentLocation);
         cout << ">> [Gun] Killed one, out of ammo. You die.\n";
         playerAlive = false;
     }
 }
 
-void resolveZombieEncounter(Player& player, Inventory& inv, ZombieSystem& zsys, bool& playerAlive) {
+void resolveZombieEncounter(Player& player, Inventory& inv, ZombieBackend& zsys, bool& playerAlive) {
     if (!playerAlive) return;
     int n = zsys.countHordesAt(player.currentLocation);
     if (n == 0) return;
     cout << "\n!! ENCOUNTER !! " << n << " zombie horde(s)!\n";
-    if (inv.contains("Gun") && inv.countItem("Ammo") > 0) {
+    int zombies = zsys.countZombiesAt(player.currentLocation);
+    if (zombies > n) cout << "   (" << zombies << " zombies in total)\n";
+    if (inv.ownsAll(ARMED_ITEMS)) {
         cout << ">> [Reflex] You fire...\n";
         useGunOnZombies(player, inv, zsys, playerAlive);
     } else {
@@ -956,8 +2641,8 @@ void resolveZombieEncounter(Player& player, Inventory& inv, ZombieSystem& zsys,
 //              INVENTORY MENU IMPL
 // =====================================================
 
-void Inventory::openMenu(Player& player, MapGraph& map, ZombieSystem& zsys, bool& playerAlive) {
-    if (!head) { cout << "\n>> [Inventory] Empty.\n"; return; }
+void Inventory::openMenu(Player& player, MapGraph& map, ZombieBackend& zsys, bool& playerAlive) {
+    if (isEmpty()) { cout << "\n>> [Inventory] Empty.\n"; return; }
     resetCurrent();
     char choice;
     do {
@@ -970,25 +2655,18 @@ void Inventory::openMenu(Player& player, MapGraph& map, ZombieSystem& zsys, bool
         switch (choice) {
         case 'n': moveNext(); break;
         case 'b': moveBack(); break;
-        case 'd': deleteCurrent(); if (!current && isEmpty()) choice = 'e'; break;
+        case 'd': deleteCurrent(); if (current < 0 && isEmpty()) choice = 'e'; break;
         case 'u':
-            if (!current) { cout << ">> Select first.\n"; break; }
+            if (current < 0) { cout << ">> Select first.\n"; break; }
             {
-                string n = current->name;
-                if (n == "Energy Drink") useEnergyDrink(player, *this, playerAlive);
-                else if (n == "Pills") usePills(player, *this, playerAlive);
-                else if (n == "Bread") useFood(player, *this, "Bread", 15);
-                else if (n == "Apple") useFood(player, *this, "Apple", 5);
-                else if (n == "Cloth") useCloth(player, *this);
-                else if (n == "Junk") useJunkAtCurrentNode(player, *this, zsys);
-                else if (n == "Pebble") usePebble(player, *this, map, zsys);
-                else if (n == "Twig") useTwig(player, *this, map, zsys);
-                else if (n == "Axe") useAxeOnBridge(map, player, *this);
-                else if (n == "Gun") cout << ">> Equip automatically during combat. Keep Ammo handy!\n";
-                else if (n == "Ammo") cout << ">> Used automatically with Gun during combat.\n";
-                else if (n == "Car Keys" || n == "Petrol") cout << ">> Use at Home to escape via Car.\n";
-                else if (n == "User ID" || n == "PIN") cout << ">> Use at Safe Zone to win.\n";
-                else cout << ">> Cannot use here.\n";
+                ItemId item = slots[current].item;
+                const ItemDef& def = ITEM_DEFS[item];
+                if (def.use) {
+                    ItemUse use = { player, *this, map, zsys, playerAlive, item };
+                    def.use(use);
+                } else {
+                    cout << ">> " << def.hint << "\n";
+                }
             }
             if (!playerAlive) choice = 'e'; else pause();
             break;
@@ -1001,7 +2679,7 @@ void Inventory::openMenu(Player& player, MapGraph& map, ZombieSystem& zsys, bool
 //                 PLAYER ACTIONS
 // =====================================================
 
-void playerMove(MapGraph& map, Player& player, MoveLog& log, ZombieSystem& zsys, int& zombieMinuteBuffer, Inventory& inv, bool& playerAlive) {
+void playerMove(MapGraph& map, Player& player, MoveLog& log, ZombieBackend& zsys, Inventory& inv, bool& playerAlive) {
     cout << "\n";
     printHeader("TRAVEL");
     cout << "You are at: " << locationToString(player.currentLocation) << "\n";
@@ -1026,17 +2704,19 @@ void playerMove(MapGraph& map, Player& player, MoveLog& log, ZombieSystem& zsys,
         cost /= 2; player.speedBoostTimer -= 30; if (player.speedBoostTimer < 0) player.speedBoostTimer = 0;
     }
 
+    Location from = player.currentLocation;
     if (map.movePlayer(player, options[choice - 1], log, cost)) {
+        zsys.interceptOnEdge(from, player.currentLocation, player.currentLocation);
         resolveZombieEncounter(player, inv, zsys, playerAlive);
         if (!playerAlive) return;
         if (rand() % 100 < 5) zsys.moveHordesToward(player.currentLocation);
-        advanceZombies(zsys, zombieMinuteBuffer, cost);
+        advanceZombies(zsys, player, cost);
         applyTimeToPlayer(player, cost, playerAlive);
         if (playerAlive && zsys.isHordeAt(player.currentLocation)) resolveZombieEncounter(player, inv, zsys, playerAlive);
     }
 }
 
-void playerScavenge(MapGraph& map, Player& player, Inventory& inv, ZombieSystem& zsys, int& zBuf, bool& alive) {
+void playerScavenge(MapGraph& map, Player& player, Inventory& inv, ZombieBackend& zsys, bool& alive) {
     cout << "\n>> [Scavenge] Searching...\n";
     
     // 15% Chance to get Scratched
@@ -1053,19 +2733,20 @@ void playerScavenge(MapGraph& map, Player& player, Inventory& inv, ZombieSystem&
     }
 
     player.timeMinutes += cost;
-    advanceZombies(zsys, zBuf, cost);
+    advanceZombies(zsys, player, cost);
     applyTimeToPlayer(player, cost, alive);
     if (!alive) return;
     if (zsys.isHordeAt(player.currentLocation)) resolveZombieEncounter(player, inv, zsys, alive);
     if (!alive) return;
 
+    map.advanceLootClock(player.timeMinutes);
     ItemProb* found = map.scavenge(player.currentLocation);
     if (!found) { cout << ">> Found nothing.\n"; return; }
     
-    cout << ">> Found: " << found->name << "!\n";
-    if (found->name == "Gun") cout << "   (It's loaded with 1 Ammo)\n";
+    cout << ">> Found: " << itemToString(found->item) << "!\n";
+    if (found->item == ITEM_GUN) cout << "   (It's loaded with 1 Ammo)\n";
 
-    if (found->name == "Backpack") {
+    if (found->item == ITEM_BACKPACK) {
         cout << "   Pick up? (P/L): "; char c; cin >> c;
         if (tolower(c) == 'p') { inv.applyBackpack(); map.removeItemChance(player.currentLocation, found); }
         return;
@@ -1074,9 +2755,9 @@ void playerScavenge(MapGraph& map, Player& player, Inventory& inv, ZombieSystem&
     cout << "   Pick (P) or Leave (L)? "; char c; cin >> c;
     if (tolower(c) == 'p') {
         // Try adding. If full, addItem returns false.
-        bool added = inv.addItem(found->name, "Item.", 1);
+        bool added = inv.addItem(found->item, "Item.", 1);
         if (added) { 
-            if (found->name == "Gun") inv.addItem("Ammo", "Round.", 1);
+            if (found->item == ITEM_GUN) inv.addItem(ITEM_AMMO, "Round.", 1);
             map.removeItemChance(player.currentLocation, found); 
         } else {
             cout << ">> Inventory Full. Swap (S)? "; char c2; cin >> c2;
@@ -1085,8 +2766,8 @@ void playerScavenge(MapGraph& map, Player& player, Inventory& inv, ZombieSystem&
                 inv.deleteByIndex(idx);
                 
                 // Try adding again after deleting
-                if (inv.addItem(found->name, "Item.", 1)) { 
-                    if (found->name == "Gun") inv.addItem("Ammo", "Round.", 1);
+                if (inv.addItem(found->item, "Item.", 1)) { 
+                    if (found->item == ITEM_GUN) inv.addItem(ITEM_AMMO, "Round.", 1);
                     map.removeItemChance(player.currentLocation, found); 
                 }
             }
@@ -1094,15 +2775,31 @@ void playerScavenge(MapGraph& map, Player& player, Inventory& inv, ZombieSystem&
     }
 }
 
-void playerRest(Player& p, Inventory& inv, ZombieSystem& zsys, int& zBuf, bool& alive) {
+void playerRest(Player& p, Inventory& inv, ZombieBackend& zsys, bool& alive) {
     cout << "\n>> [Rest] Taking a break...\n";
     p.timeMinutes += 60;
-    advanceZombies(zsys, zBuf, 60);
+    advanceZombies(zsys, p, 60);
     applyTimeToPlayer(p, 60, alive);
     if (alive && zsys.isHordeAt(p.currentLocation)) resolveZombieEncounter(p, inv, zsys, alive);
     if (alive) { p.stamina = min(100, p.stamina + 30); cout << ">> Stamina recovered.\n"; }
 }
 
+// Eight hours in one go: the zombies fast-forward quietly and only the outcome is reported
+void playerSleep(Player& p, Inventory& inv, ZombieBackend& zsys, bool& alive) {
+    const int hours = 8;
+    cout << "\n>> [Sleep] You barricade yourself in and sleep for " << hours << " hours...\n";
+    p.timeMinutes += hours * 60;
+    FastForwardSummary night = zsys.fastForward(hours, p.currentLocation);
+    if (night.infections > 0) cout << ">> [Night] " << night.infections << " location(s) fell to the infection.\n";
+    if (night.spawns > 0) cout << ">> [Night] " << night.spawns << " new horde(s) roam the city.\n";
+    applyTimeToPlayer(p, hours * 60, alive);
+    if (alive && night.hordesAtPlayer > 0) {
+        cout << ">> [Night] You wake to groaning at the door!\n";
+        resolveZombieEncounter(p, inv, zsys, alive);
+    }
+    if (alive) { p.stamina = 100; cout << ">> Fully rested.\n"; }
+}
+
 void undoLastMove(Player& p, MoveLog& log) {
     Location pl; int pt;
     if (log.pop(pl, pt)) { p.currentLocation = pl; p.timeMinutes = pt; cout << ">> [Undo] Time rewind.\n"; }
@@ -1111,15 +2808,15 @@ void undoLastMove(Player& p, MoveLog& log) {
 
 void tryCarEscape(Player& p, Inventory& inv, bool& won) {
     if (p.currentLocation != HOME) { cout << ">> Go Home first.\n"; return; }
-    if (!inv.contains("Car Keys")) { cout << ">> Need Car Keys.\n"; return; }
-    if (inv.countItem("Petrol") < 2) { cout << ">> Need 2 Petrol units.\n"; return; }
-    cout << ">> [Car] Turning ignition...\n"; inv.consumeMany("Petrol", 2);
+    if (!inv.contains(ITEM_CAR_KEYS)) { cout << ">> Need Car Keys.\n"; return; }
+    if (inv.countItem(ITEM_PETROL) < 2) { cout << ">> Need 2 Petrol units.\n"; return; }
+    cout << ">> [Car] Turning ignition...\n"; inv.consumeMany(ITEM_PETROL, 2);
     if (rand() % 100 < 70) { cout << "\n*** CAR ESCAPE VICTORY! ***\n"; won = true; }
     else cout << ">> [Car] Engine dead.\n";
 }
 
 void checkWin(Player& p, Inventory& inv, bool& won) {
-    if (!won && p.currentLocation == SAFE_ZONE && inv.contains("PIN") && inv.contains("User ID")) {
+    if (!won && p.currentLocation == SAFE_ZONE && inv.ownsAll(WIN_ITEMS)) {
         cout << "\n*** SAFE ZONE VICTORY! ***\n"; won = true;
     }
 }
@@ -1136,10 +2833,14 @@ void printHUD(Player& p, Inventory& inv) {
     cout << "+-------------------------------------------------------------+\n";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     srand(time(0));
-    MapGraph map; Inventory inv(8); MoveLog log; ZombieSystem zsys(&map);
-    int zBuf = 0; zsys.addInitialHorde(LAB);
+    // --crowd: count-based zombies (AggregateZombieSystem) instead of one object per horde
+    bool crowd = argc > 1 && string(argv[1]) == "--crowd";
+    MapGraph map; Inventory inv(8); MoveLog log;
+    ZombieBackend* zombies = crowd ? (ZombieBackend*)new AggregateZombieSystem(&map) : new ZombieSystem(&map);
+    ZombieBackend& zsys = *zombies;
+    zsys.addInitialHorde(LAB);
     Player p = { TOWN_HALL, 0, 100, 0, 100, false, false, 0, 0, 0 };
     bool alive = true; bool won = false;
 
@@ -1149,16 +2850,17 @@ int main() {
     do {
         clearScreen();
         printHUD(p, inv);
-        cout << " [1] Move         [2] Scavenge    [3] Rest\n";
+        cout << " [1] Move         [2] Scavenge    [3] Rest        [4] Sleep\n";
         cout << " [M] Map          [G] Attack      [I] Inventory\n";
         cout << " [K] Car Escape   [U] Undo        [Q] Quit\n";
         cout << "\n >> Command: ";
         cin >> c;
 
         switch (c) {
-        case '1': playerMove(map, p, log, zsys, zBuf, inv, alive); break;
-        case '2': playerScavenge(map, p, inv, zsys, zBuf, alive); break;
-        case '3': playerRest(p, inv, zsys, zBuf, alive); break;
+        case '1': playerMove(map, p, log, zsys, inv, alive); break;
+        case '2': playerScavenge(map, p, inv, zsys, alive); break;
+        case '3': playerRest(p, inv, zsys, alive); break;
+        case '4': playerSleep(p, inv, zsys, alive); break;
         case 'm': case 'M': map.displayVisualMap(p, zsys); break; 
         case 'g': case 'G': useGunOnZombies(p, inv, zsys, alive); break;
         case 'i': case 'I': inv.openMenu(p, map, zsys, alive); break;
@@ -1175,5 +2877,6 @@ int main() {
     } while (c != 'q' && c != 'Q');
 
     if (!alive) cout << "\n>> GAME OVER. <<\n";
+    delete zombies;
     return 0;
 }
@@ -121,11 +121,17 @@ class LocationQueue {
 private:
     QNode* head;
     QNode* tail;
+    QNode* freeNodes; // popped nodes kept for reuse by push
 public:
-    LocationQueue() { head = tail = NULL; }
+    LocationQueue() { head = tail = freeNodes = NULL; }
     
     ~LocationQueue() {
         while (!isEmpty()) pop();
+        while (freeNodes) {
+            QNode* temp = freeNodes;
+            freeNodes = freeNodes->next;
+            delete temp;
+        }
     }
 
     bool isEmpty() {
@@ -133,7 +139,15 @@ public:
     }
 
     void push(Location val) {
-        QNode* newNode = new QNode(val);
+        QNode* newNode;
+        if (freeNodes) {
+            newNode = freeNodes;
+            freeNodes = freeNodes->next;
+            newNode->data = val;
+            newNode->next = NULL;
+        } else {
+            newNode = new QNode(val);
+        }
         if (tail == NULL) {
             head = tail = newNode;
             return;
@@ -147,7 +161,8 @@ public:
         QNode* temp = head;
         head = head->next;
         if (head == NULL) tail = NULL;
-        delete temp;
+        temp->next = freeNodes;
+        freeNodes = temp;
     }
 
     Location front() {
@@ -193,18 +208,32 @@ private:
     InvNode* head;
     InvNode* tail;
     InvNode* current;
+    InvNode* freeNodes; // discarded nodes kept for reuse by addItem
     int capacity;
     int usedSlots; 
     bool hasBackpack;
 
 public:
     Inventory(int cap = 8) {
-        head = tail = current = NULL;
+        head = tail = current = freeNodes = NULL;
         capacity = cap;
         usedSlots = 0;
         hasBackpack = false;
     }
 
+    ~Inventory() {
+        while (head) {
+            InvNode* temp = head;
+            head = head->next;
+            delete temp;
+        }
+        while (freeNodes) {
+            InvNode* temp = freeNodes;
+            freeNodes = freeNodes->next;
+            delete temp;
+        }
+    }
+
     bool isEmpty() const { return head == NULL; }
     bool isFull() const { return usedSlots >= capacity; } 
     int getCapacity() const { return capacity; }
@@ -245,7 +274,17 @@ public:
             temp = temp->next;
         }
 
-        InvNode* node = new InvNode(name, desc, quantity);
+        InvNode* node;
+        if (freeNodes) {
+            node = freeNodes;
+            freeNodes = freeNodes->next;
+            node->name = name;
+            node->description = desc;
+            node->quantity = quantity;
+            node->prev = node->next = NULL;
+        } else {
+            node = new InvNode(name, desc, quantity);
+        }
         if (!head) { head = tail = node; }
         else { tail->next = node; node->prev = tail; tail = node; }
         
@@ -268,7 +307,8 @@ public:
             if (node->next) current = node->next;
             else current = node->prev;
         }
-        delete node;
+        node->next = freeNodes;
+        freeNodes = node;
     }
 
     void deleteCurrent() {
@@ -374,55 +414,57 @@ public:
 //              OTHER SYSTEMS
 // =====================================================
 
-struct MoveNodeDLL {
+// One undoable move: where the player was and the clock before it
+struct MoveRecord {
     Location locBefore;
     int timeBefore;
-    MoveNodeDLL* prev;
-    MoveNodeDLL* next;
-    MoveNodeDLL(Location l, int t) : locBefore(l), timeBefore(t), prev(NULL), next(NULL) {}
 };
 
-class MoveLog {
+// Undo history as a fixed ring buffer: the newest Depth moves are kept and
+// older ones are overwritten, so undo never allocates
+template <int Depth>
+class MoveRing {
 private:
-    MoveNodeDLL* head;
-    MoveNodeDLL* tail;
+    MoveRecord ring[Depth];
+    int newest; // index of the last pushed record
+    int count;
 public:
-    MoveLog() { head = tail = NULL; }
-    bool isEmpty() const { return tail == NULL; }
+    MoveRing() : newest(Depth - 1), count(0) {}
+    bool isEmpty() const { return count == 0; }
     void push(Location locBefore, int timeBefore) {
-        MoveNodeDLL* node = new MoveNodeDLL(locBefore, timeBefore);
-        if (!head) head = tail = node;
-        else { tail->next = node; node->prev = tail; tail = node; }
+        newest = (newest + 1 == Depth) ? 0 : newest + 1;
+        ring[newest].locBefore = locBefore;
+        ring[newest].timeBefore = timeBefore;
+        if (count < Depth) count++;
     }
     bool pop(Location& locOut, int& timeOut) {
-        if (!tail) return false;
-        MoveNodeDLL* node = tail;
-        locOut = node->locBefore;
-        timeOut = node->timeBefore;
-        tail = node->prev;
-        if (tail) tail->next = NULL;
-        else head = NULL;
-        delete node;
+        if (count == 0) return false;
+        locOut = ring[newest].locBefore;
+        timeOut = ring[newest].timeBefore;
+        newest = (newest == 0) ? Depth - 1 : newest - 1;
+        count--;
         return true;
     }
 };
+typedef MoveRing<64> MoveLog;
 
 // =====================================================
 //                  ZOMBIE SYSTEM
 // =====================================================
+// Lives in ZombieSystem::infectionNodes; children are indices into it, -1 = none
 struct InfectionNode {
     Location loc;
-    InfectionNode* left;
-    InfectionNode* right;
-    InfectionNode(Location l) : loc(l), left(nullptr), right(nullptr) {}
+    int left;
+    int right;
+    InfectionNode(Location l) : loc(l), left(-1), right(-1) {}
 };
 
 struct ZombieHorde {
     int id;
     Location currentLocation;
     int infectionRate;
-    InfectionNode* treeNode;
-    ZombieHorde(int _id, Location loc, int rate, InfectionNode* node)
+    int treeNode; // index into ZombieSystem::infectionNodes
+    ZombieHorde(int _id, Location loc, int rate, int node)
         : id(_id), currentLocation(loc), infectionRate(rate), treeNode(node) {}
 };
 
@@ -433,15 +475,17 @@ private:
     int distractionTurns[COUNT];
     int nextId;
     bool infected[COUNT];
-    InfectionNode* infectionRoot;
+    vector<InfectionNode> infectionNodes; // every node of the infection tree, freed with the system
+    int infectionRoot;                    // -1 until the first horde is placed
     MapGraph* map; 
 
 public:
     ZombieSystem(MapGraph* m); 
 
     void addInitialHorde(Location loc) {
-        InfectionNode* node = new InfectionNode(loc);
-        if (!infectionRoot) infectionRoot = node;
+        int node = (int)infectionNodes.size();
+        infectionNodes.push_back(InfectionNode(loc));
+        if (infectionRoot < 0) infectionRoot = node;
         ZombieHorde h(nextId++, loc, 5, node); // Starts at 5%
         hordes.push_back(h);
         infected[loc] = true;
@@ -513,6 +557,17 @@ public:
         initItemProbabilities();
     }
 
+    // Edges are never removed, so the adjacency lists live as long as the map
+    ~MapGraph() {
+        for (int i = 0; i < COUNT; i++) {
+            while (adj[i]) {
+                Node* temp = adj[i];
+                adj[i] = adj[i]->next;
+                delete temp;
+            }
+        }
+    }
+
     void addEdge(Location a, Location b) {
         // Prevent duplicates
         Node* temp = adj[a];
@@ -703,7 +758,7 @@ ZombieSystem::ZombieSystem(MapGraph* m) {
         distractionTurns[i] = 0;
         infected[i] = false;
     }
-    infectionRoot = nullptr;
+    infectionRoot = -1;
 }
 
 bool ZombieSystem::hasDistractionAnywhere() {
@@ -834,9 +889,11 @@ void ZombieSystem::checkInfection(ZombieHorde& zombie, vector<ZombieHorde>& newH
             cout << "     >> " << locationToString(zombie.currentLocation) << " HAS BEEN INFECTED!\n";
             infected[zombie.currentLocation] = true;
             zombie.infectionRate = 5;
-            InfectionNode* child = new InfectionNode(zombie.currentLocation);
-            if (!zombie.treeNode->left) zombie.treeNode->left = child;
-            else if (!zombie.treeNode->right) zombie.treeNode->right = child;
+            int child = (int)infectionNodes.size();
+            infectionNodes.push_back(InfectionNode(zombie.currentLocation));
+            InfectionNode& parent = infectionNodes[zombie.treeNode];
+            if (parent.left < 0) parent.left = child;
+            else if (parent.right < 0) parent.right = child;
             ZombieHorde splitHorde(nextId++, zombie.currentLocation, 5, child);
             newHordes.push_back(splitHorde);
             cout << "     >> WARNING: A new horde has spawned!\n";
@@ -359,62 +359,41 @@ public:
 };
 
 // =====================================================
-//              UNDO MOVE LOG (DOUBLY LINKED LIST)
+//              UNDO MOVE LOG (RING BUFFER)
 // =====================================================
-struct MoveNodeDLL {
+// One undoable move: where the player was and the clock before it
+struct MoveRecord {
     Location locBefore;
     int timeBefore;
-    MoveNodeDLL* prev;
-    MoveNodeDLL* next;
-
-    MoveNodeDLL(Location l, int t) : locBefore(l), timeBefore(t), prev(NULL), next(NULL) {}
 };
 
-class MoveLog {
+// Undo history as a fixed ring buffer: the newest Depth moves are kept and
+// older ones are overwritten, so undo never allocates
+template <int Depth>
+class MoveRing {
 private:
-    MoveNodeDLL* head;
-    MoveNodeDLL* tail; // we treat tail as top of stack
-
+    MoveRecord ring[Depth];
+    int newest; // index of the last pushed record
+    int count;
 public:
-    MoveLog() {
-        head = tail = NULL;
-    }
-
-    bool isEmpty() const {
-        return tail == NULL;
-    }
-
-    // Store state BEFORE move
+    MoveRing() : newest(Depth - 1), count(0) {}
+    bool isEmpty() const { return count == 0; }
     void push(Location locBefore, int timeBefore) {
-        MoveNodeDLL* node = new MoveNodeDLL(locBefore, timeBefore);
-        if (!head) {
-            head = tail = node;
-        }
-        else {
-            tail->next = node;
-            node->prev = tail;
-            tail = node;
-        }
-        // cout << "[MoveLog] Pushed state: " << locationToString(locBefore)
-        //      << ", time " << timeBefore << "\n";
+        newest = (newest + 1 == Depth) ? 0 : newest + 1;
+        ring[newest].locBefore = locBefore;
+        ring[newest].timeBefore = timeBefore;
+        if (count < Depth) count++;
     }
-
-    // Pop last state, returns true if successful and writes into parameters
     bool pop(Location& locOut, int& timeOut) {
-        if (!tail) return false;
-
-        MoveNodeDLL* node = tail;
-        locOut = node->locBefore;
-        timeOut = node->timeBefore;
-
-        tail = node->prev;
-        if (tail) tail->next = NULL;
-        else head = NULL;
-
-        delete node;
+        if (count == 0) return false;
+        locOut = ring[newest].locBefore;
+        timeOut = ring[newest].timeBefore;
+        newest = (newest == 0) ? Depth - 1 : newest - 1;
+        count--;
         return true;
     }
 };
+typedef MoveRing<64> MoveLog;
 
 // =====================================================
 //                      MAP (GRAPH)
@@ -1267,7 +1246,7 @@ void useGunOnZombies(Player& player, Inventory& inv, ZombieSystem& zsys, bool& p
     }
 }
 
-// Undo last move using MoveLog DLL
+// Undo last move using the MoveLog ring
 void undoLastMove(Player& player, MoveLog& log) {
     Location prevLoc;
     int prevTime;
@@ -3,6 +3,7 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <cmath>
 using namespace std;
 
 // ---------- LOCATIONS ----------
@@ -450,73 +451,59 @@ public:
 };
 
 // =====================================================
-//              UNDO MOVE LOG (DOUBLY LINKED LIST)
+//              UNDO MOVE LOG (RING BUFFER)
 // =====================================================
-struct MoveNodeDLL
+// One undoable move: where the player was and the clock before it
+struct MoveRecord
 {
     Location locBefore;
     int timeBefore;
-    MoveNodeDLL *prev;
-    MoveNodeDLL *next;
-
-    MoveNodeDLL(Location l, int t) : locBefore(l), timeBefore(t), prev(NULL), next(NULL) {}
 };
 
-class MoveLog
+// Undo history as a fixed ring buffer: the newest Depth moves are kept and
+// older ones are overwritten, so undo never allocates
+template <int Depth>
+class MoveRing
 {
 private:
-    MoveNodeDLL *head;
-    MoveNodeDLL *tail; // we treat tail as top of stack
+    MoveRecord ring[Depth];
+    int newest; // index of the last pushed record
+    int count;
 
 public:
-    MoveLog()
-    {
-        head = tail = NULL;
-    }
+    MoveRing() : newest(Depth - 1), count(0) {}
 
     bool isEmpty() const
     {
-        return tail == NULL;
+        return count == 0;
     }
 
     // Store state BEFORE move
     void push(Location locBefore, int timeBefore)
     {
-        MoveNodeDLL *node = new MoveNodeDLL(locBefore, timeBefore);
-        if (!head)
+        newest = (newest + 1 == Depth) ? 0 : newest + 1;
+        ring[newest].locBefore = locBefore;
+        ring[newest].timeBefore = timeBefore;
+        if (count < Depth)
         {
-            head = tail = node;
+            count++;
         }
-        else
-        {
-            tail->next = node;
-            node->prev = tail;
-            tail = node;
-        }
-        // cout << "[MoveLog] Pushed state: " << locationToString(locBefore)
-        //      << ", time " << timeBefore << "\n";
     }
 
     // Pop last state, returns true if successful and writes into parameters
     bool pop(Location &locOut, int &timeOut)
     {
-        if (!tail)
+        if (count == 0)
             return false;
 
-        MoveNodeDLL *node = tail;
-        locOut = node->locBefore;
-        timeOut = node->timeBefore;
-
-        tail = node->prev;
-        if (tail)
-            tail->next = NULL;
-        else
-            head = NULL;
-
-        delete node;
+        locOut = ring[newest].locBefore;
+        timeOut = ring[newest].timeBefore;
+        newest = (newest == 0) ? Depth - 1 : newest - 1;
+        count--;
         return true;
     }
 };
+typedef MoveRing<64> MoveLog;
 
 // =====================================================
 //                      MAP (GRAPH)
@@ -577,6 +564,25 @@ public:
         return adj[loc];
     }
 
+    // Flatten the adjacency lists into CSR form:
+    // neighbours of u are targets[offsets[u]] .. targets[offsets[u + 1] - 1]
+    void buildCSR(vector<int> &offsets, vector<int> &targets)
+    {
+        offsets.assign(COUNT + 1, 0);
+        targets.clear();
+        for (int u = 0; u < COUNT; u++)
+        {
+            offsets[u] = (int)targets.size();
+            Node *temp = adj[u];
+            while (temp != NULL)
+            {
+                targets.push_back(temp->vertex);
+                temp = temp->next;
+            }
+        }
+        offsets[COUNT] = (int)targets.size();
+    }
+
     bool isConnected(Location from, Location to)
     {
         Node *temp = adj[from];
@@ -800,14 +806,98 @@ private:
 //                  ZOMBIE SYSTEM (MINIMAL)
 // =====================================================
 
-// Infection tree node: which location infected which
+// Infection tree node: which location infected which.
+// Nodes are stored in one vector (InfectionTree) and linked by index,
+// so a node can have any number of children and nothing is leaked.
 struct InfectionNode
 {
     Location loc;
-    InfectionNode *left;
-    InfectionNode *right;
+    int parent;      // -1 for an outbreak root
+    int firstChild;  // -1 if none
+    int lastChild;   // -1 if none
+    int nextSibling; // -1 if last child
+    int depth;       // roots are depth 0
+    int subtreeSize; // this node plus all descendants
+    int infectedAt;  // zombie hour of the infection
+};
+
+class InfectionTree
+{
+private:
+    vector<InfectionNode> nodes;
+    vector<int> roots;
+    int nodeOfLocation[COUNT]; // -1 = never infected
 
-    InfectionNode(Location l) : loc(l), left(nullptr), right(nullptr) {}
+    int newNode(Location loc, int parent, int depth, int hour)
+    {
+        InfectionNode n = {loc, parent, -1, -1, -1, depth, 1, hour};
+        nodes.push_back(n);
+        if (nodeOfLocation[loc] < 0)
+        {
+            nodeOfLocation[loc] = (int)nodes.size() - 1; // first infection wins
+        }
+        return (int)nodes.size() - 1;
+    }
+
+public:
+    InfectionTree()
+    {
+        for (int i = 0; i < COUNT; ++i)
+        {
+            nodeOfLocation[i] = -1;
+        }
+    }
+
+    // Every initial horde starts its own lineage, even on a node that is already infected
+    int addRoot(Location loc, int hour)
+    {
+        int id = newNode(loc, -1, 0, hour);
+        roots.push_back(id);
+        return id;
+    }
+
+    // Append a child; walks up once so subtreeSize() stays O(1)
+    int addChild(int parent, Location loc, int hour)
+    {
+        int id = newNode(loc, parent, nodes[parent].depth + 1, hour);
+        InfectionNode &p = nodes[parent];
+        if (p.lastChild < 0)
+            p.firstChild = id;
+        else
+            nodes[p.lastChild].nextSibling = id;
+        p.lastChild = id;
+
+        for (int a = parent; a >= 0; a = nodes[a].parent)
+        {
+            nodes[a].subtreeSize++;
+        }
+        return id;
+    }
+
+    const InfectionNode &node(int id) const { return nodes[id]; }
+    int size() const { return (int)nodes.size(); }
+    const vector<int> &getRoots() const { return roots; }
+    int nodeAt(Location loc) const { return nodeOfLocation[loc]; }
+    int depth(int id) const { return nodes[id].depth; }
+    int subtreeSize(int id) const { return nodes[id].subtreeSize; }
+
+    // Zombie hour the location was infected, -1 if still clean
+    int infectedAt(Location loc) const
+    {
+        int id = nodeOfLocation[loc];
+        return id < 0 ? -1 : nodes[id].infectedAt;
+    }
+
+    // Lineage from the outbreak root down to this node
+    vector<Location> ancestorChain(int id) const
+    {
+        vector<Location> chain(nodes[id].depth + 1);
+        for (int a = id; a >= 0; a = nodes[a].parent)
+        {
+            chain[nodes[a].depth] = nodes[a].loc;
+        }
+        return chain;
+    }
 };
 
 struct ZombieHorde
@@ -815,10 +905,10 @@ struct ZombieHorde
     int id;
     Location currentLocation;
     int infectionRate;       // % (starts at 10, +5 per move)
-    InfectionNode *treeNode; // pointer into infection tree
+    int treeNode;            // index into the InfectionTree
 
     ZombieHorde() {}
-    ZombieHorde(int _id, Location loc, int rate, InfectionNode *node)
+    ZombieHorde(int _id, Location loc, int rate, int node)
         : id(_id), currentLocation(loc), infectionRate(rate), treeNode(node)
     {
     }
@@ -832,7 +922,8 @@ private:
     int junkBlocks[COUNT]; // Junk protection duration per node (in zombie moves)
     int nextId;
     bool infected[COUNT];
-    InfectionNode *infectionRoot;
+    InfectionTree tree;
+    int zombieHours; // hours simulated so far (infection timestamps)
 
 public:
     ZombieSystem(MapGraph *m)
@@ -844,22 +935,14 @@ public:
             junkBlocks[i] = 0;
             infected[i] = false;
         }
-        infectionRoot = nullptr;
+        zombieHours = 0;
     }
 
+    const InfectionTree &infectionTree() const { return tree; }
+
     void addInitialHorde(Location loc)
     {
-        InfectionNode *node = new InfectionNode(loc);
-
-        if (!infectionRoot)
-        {
-            infectionRoot = node; // first outbreak root
-        }
-        else
-        {
-            // If you ever want multiple roots, you can attach it somewhere else
-            // For now, keep first infected as root.
-        }
+        int node = tree.addRoot(loc, zombieHours);
 
         ZombieHorde h(nextId++, loc, 10, node); // start infectionRate at 10%
         hordes.push_back(h);
@@ -883,6 +966,7 @@ public:
     void simulateHour()
     {
         cout << "\n=== ZOMBIES MOVE (1 HOUR) ===\n";
+        zombieHours++;
 
         vector<ZombieHorde> newHordes;
 
@@ -1049,12 +1133,7 @@ public:
                 zombie.infectionRate = 10;
 
                 // ---- Infection tree: add child node ----
-                InfectionNode *child = new InfectionNode(newLoc);
-                if (!zombie.treeNode->left)
-                    zombie.treeNode->left = child;
-                else if (!zombie.treeNode->right)
-                    zombie.treeNode->right = child;
-                // if both occupied, you could decide to ignore OR pick randomly
+                int child = tree.addChild(zombie.treeNode, newLoc, zombieHours);
 
                 // ---- Split: create a NEW independent horde at newLoc ----
                 ZombieHorde splitHorde(nextId++, newLoc, 10, child);
@@ -1078,6 +1157,94 @@ public:
         return false;
     }
 
+    // ----- THREAT HEATMAP (exact, no rollouts) -----
+    // Horde movement is a Markov chain: 15% stay, otherwise a uniform pick among
+    // neighbours that are not Junk-blocked (stay if all are blocked). Junk timers
+    // are known, so the chain for each future hour is known too.
+    // heat[t][loc] = probability that at least one current horde is at loc after t zombie hours.
+    // expected (optional) gets the expected number of hordes there.
+    // Hordes spawned by future infections and scent moves are not modelled.
+    vector<vector<double>> threatHeatmap(int hours, vector<vector<double>> *expected = NULL)
+    {
+        vector<int> offsets, targets;
+        map->buildCSR(offsets, targets);
+
+        // Hordes on the same node share one distribution: dist[s][loc], weighted by count[s]
+        int countAt[COUNT] = {0};
+        for (auto &h : hordes)
+            countAt[h.currentLocation]++;
+        vector<int> starts;
+        for (int i = 0; i < COUNT; i++)
+        {
+            if (countAt[i] > 0)
+                starts.push_back(i);
+        }
+        vector<vector<double>> dist(starts.size(), vector<double>(COUNT, 0.0));
+        for (size_t s = 0; s < starts.size(); s++)
+            dist[s][starts[s]] = 1.0;
+
+        vector<vector<double>> heat(hours + 1, vector<double>(COUNT, 0.0));
+        if (expected)
+            expected->assign(hours + 1, vector<double>(COUNT, 0.0));
+
+        vector<double> next(COUNT);
+        for (int t = 0; t <= hours; t++)
+        {
+            if (t > 0)
+            {
+                // Junk placed now still blocks for junkBlocks[] more zombie hours
+                bool blocked[COUNT];
+                for (int i = 0; i < COUNT; i++)
+                    blocked[i] = junkBlocks[i] - (t - 1) > 0;
+
+                for (size_t s = 0; s < starts.size(); s++)
+                {
+                    // One sparse matrix-vector product over the CSR graph
+                    for (int i = 0; i < COUNT; i++)
+                        next[i] = 0.0;
+                    for (int u = 0; u < COUNT; u++)
+                    {
+                        double p = dist[s][u];
+                        if (p == 0.0)
+                            continue;
+                        int open = 0;
+                        for (int e = offsets[u]; e < offsets[u + 1]; e++)
+                        {
+                            if (!blocked[targets[e]])
+                                open++;
+                        }
+                        if (open == 0)
+                        {
+                            next[u] += p;
+                            continue;
+                        }
+                        next[u] += p * 0.15;
+                        double share = p * 0.85 / open;
+                        for (int e = offsets[u]; e < offsets[u + 1]; e++)
+                        {
+                            if (!blocked[targets[e]])
+                                next[targets[e]] += share;
+                        }
+                    }
+                    dist[s] = next;
+                }
+            }
+
+            for (int loc = 0; loc < COUNT; loc++)
+            {
+                double none = 1.0;
+                for (size_t s = 0; s < starts.size(); s++)
+                {
+                    none *= pow(1.0 - dist[s][loc], countAt[starts[s]]);
+                    if (expected)
+                        (*expected)[t][loc] += countAt[starts[s]] * dist[s][loc];
+                }
+                heat[t][loc] = 1.0 - none;
+            }
+        }
+        return heat;
+    }
+
 private:
     void moveHordeOneStep(ZombieHorde &zombie)
     {
@@ -1230,6 +1397,32 @@ void useEnergyDrink(Player &player, Inventory &inv, bool &playerAlive)
     }
 }
 
+// Threat forecast: chance a horde is at your node or a neighbour in the next 3 zombie hours
+void showThreatForecast(MapGraph &map, Player &player, ZombieSystem &zsys)
+{
+    const int hours = 3;
+    vector<vector<double>> heat = zsys.threatHeatmap(hours);
+
+    vector<Location> locs;
+    locs.push_back(player.currentLocation);
+    Node *n = map.getNeighbors(player.currentLocation);
+    while (n != NULL)
+    {
+        locs.push_back((Location)n->vertex);
+        n = n->next;
+    }
+
+    cout << "\n[Forecast] Chance of a zombie horde (next " << hours << " hours):\n";
+    for (Location loc : locs)
+    {
+        cout << " - " << locationToString(loc) << ":";
+        for (int t = 1; t <= hours; t++)
+            cout << "  +" << t << "h " << (int)(heat[t][loc] * 100 + 0.5) << "%";
+        cout << "\n";
+    }
+    cout << "\n";
+}
+
 void resolveZombieEncounter(Player &player, Inventory &inv, ZombieSystem &zsys, bool &playerAlive);
 // =====================================================
 //                 PLAYER ACTIONS
@@ -1714,7 +1907,7 @@ void resolveZombieEncounter(Player &player,
     }
 }
 
-// Undo last move using MoveLog DLL
+// Undo last move using the MoveLog ring
 void undoLastMove(Player &player, MoveLog &log)
 {
     Location prevLoc;
@@ -1812,6 +2005,78 @@ void tryCarEscape(Player &player, Inventory &inv, bool &gameWon)
     }
 }
 
+// =====================================================
+//               ITEM COMMAND TABLE
+// =====================================================
+// Everything an item command may need to touch.
+struct ItemCommandContext
+{
+    Player &player;
+    Inventory &inv;
+    MapGraph &map;
+    ZombieSystem &zsys;
+    bool &playerAlive;
+    bool &gameWon;
+};
+
+typedef void (*ItemCommandFn)(ItemCommandContext &ctx);
+
+// One row per item command of the main menu (using, viewing or spending
+// items). The menu lines are printed from this table in row order and the
+// key is turned into a row index once, so adding an item command means
+// adding a row here and nothing in main().
+struct ItemCommand
+{
+    char key; // lowercase; the uppercase key works too
+    const char *menuText;
+    ItemCommandFn run;
+};
+
+const ItemCommand ITEM_COMMANDS[] = {
+    {'a', "Use an axe on Bridge barricade (no time cost)",
+     [](ItemCommandContext &c) { useAxeOnBridge(c.map, c.player, c.inv); }},
+    {'c', "Use cloth (no time costs)",
+     [](ItemCommandContext &c) { useCloth(c.player, c.inv); }},
+    {'e', "Drink energy drink (no time cost)",
+     [](ItemCommandContext &c) { useEnergyDrink(c.player, c.inv, c.playerAlive); }},
+    {'j', "Use junk on this node (no time cost)",
+     [](ItemCommandContext &c) { useJunkAtCurrentNode(c.player, c.inv, c.zsys); }},
+    {'g', "Use gun on nearby zombies (no time cost)",
+     [](ItemCommandContext &c) { useGunOnZombies(c.player, c.inv, c.zsys, c.playerAlive); }},
+    {'i', "Inventory  (no time cost)",
+     [](ItemCommandContext &c) { c.inv.openMenu(); }},
+    {'k', "Try car escape (HOME only, no time cost)",
+     [](ItemCommandContext &c) { tryCarEscape(c.player, c.inv, c.gameWon); }},
+    {'p', "Take pills (no time cost)",
+     [](ItemCommandContext &c) { usePills(c.player, c.inv, c.playerAlive); }},
+};
+const int ITEM_COMMAND_COUNT = sizeof(ITEM_COMMANDS) / sizeof(ITEM_COMMANDS[0]);
+
+// Returns the row bound to this key, or nullptr if it is not an item command.
+const ItemCommand *findItemCommand(char key)
+{
+    static const ItemCommand *byLetter[26] = {nullptr};
+    static bool built = false;
+    if (!built)
+    {
+        for (int i = 0; i < ITEM_COMMAND_COUNT; i++)
+        {
+            byLetter[ITEM_COMMANDS[i].key - 'a'] = &ITEM_COMMANDS[i];
+        }
+        built = true;
+    }
+
+    if (key >= 'A' && key <= 'Z')
+    {
+        key = key - 'A' + 'a';
+    }
+    if (key < 'a' || key > 'z')
+    {
+        return nullptr;
+    }
+    return byLetter[key - 'a'];
+}
+
 // =====================================================
 //                  MAIN GAME LOOP DEMO
 // =====================================================
@@ -1846,6 +2111,8 @@ int main()
     bool playerAlive = true;
     bool gameWon = false;
 
+    ItemCommandContext itemCtx = {player, inventory, map, zsys, playerAlive, gameWon};
+
     cout << "=== SURVIVAL GAME DEMO: INVENTORY + UNDO + ZOMBIES + ITEMS ===\n";
     map.printMap();
 
@@ -1877,14 +2144,11 @@ int main()
         cout << "1. Move       (costs 1 hour)\n";
         cout << "2. Scavenge   (costs 30 minutes)\n";
         cout << "3. Rest       (costs 1 hour, restores stamina)\n";
-        cout << "a. Use an axe on Bridge barricade (no time cost)\n";
-        cout << "c. Use cloth (no time costs)\n";
-        cout << "e. Drink energy drink (no time cost)\n";
-        cout << "j. Use junk on this node (no time cost)\n";
-        cout << "g. Use gun on nearby zombies (no time cost)\n";
-        cout << "i. Inventory  (no time cost)\n";
-        cout << "k. Try car escape (HOME only, no time cost)\n";
-        cout << "p. Take pills (no time cost)\n";
+        for (int i = 0; i < ITEM_COMMAND_COUNT; i++)
+        {
+            cout << ITEM_COMMANDS[i].key << ". " << ITEM_COMMANDS[i].menuText << "\n";
+        }
+        cout << "t. Threat forecast (no time cost)\n";
         cout << "u. Undo last move (no time cost)\n";
         cout << "q. Quit\n";
         cout << "Enter choice: ";
@@ -1901,37 +2165,9 @@ int main()
         case '3':
             playerRest(player, inventory, zsys, zombieMinuteBuffer, playerAlive);
             break;
-        case 'a':
-        case 'A':
-            useAxeOnBridge(map, player, inventory);
-            break;
-        case 'c':
-        case 'C':
-            useCloth(player, inventory);
-            break;
-        case 'e':
-        case 'E':
-            useEnergyDrink(player, inventory, playerAlive);
-            break;
-        case 'j':
-        case 'J':
-            useJunkAtCurrentNode(player, inventory, zsys);
-            break;
-        case 'g':
-        case 'G':
-            useGunOnZombies(player, inventory, zsys, playerAlive);
-            break;
-        case 'i':
-        case 'I':
-            inventory.openMenu(); // no time cost
-            break;
-        case 'k':
-        case 'K':
-            tryCarEscape(player, inventory, gameWon);
-            break;
-        case 'p':
-        case 'P':
-            usePills(player, inventory, playerAlive);
+        case 't':
+        case 'T':
+            showThreatForecast(map, player, zsys);
             break;
         case 'u':
         case 'U':
@@ -1942,7 +2178,17 @@ int main()
             cout << "Exiting game loop.\n";
             break;
         default:
-            cout << "Invalid choice.\n";
+        {
+            const ItemCommand *cmd = findItemCommand(choice);
+            if (cmd)
+            {
+                cmd->run(itemCtx);
+            }
+            else
+            {
+                cout << "Invalid choice.\n";
+            }
+        }
         }
 
         checkPrimaryWin(player, inventory, gameWon);